@@ -0,0 +1,323 @@
+/**
+ * @file frame_bench.cpp
+ * @brief 分隔符扫描与帧切分的吞吐基准测试
+ * @note 编译：g++ -std=c++11 -O2 -I. bench/frame_bench.cpp -o frame_bench
+ *       对录制的抓包文件（--capture，原始字节流）或合成数据，分别用逐字节、SSE2、AVX2、NEON
+ *       （CPU不支持的跳过）以及memchr()测量：
+ *         scan : 在整段数据上查找全部分隔符的速率（GB/s，1GB = 10^9字节）；
+ *         frame: 按--read字节一次写入UartFrameScanner并取出全部帧的速率，模拟每次receive()之后的处理。
+ *       结果以JSON（默认）或CSV输出
+ */
+
+// 标准库
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "uart_frame.hpp"
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+/**
+ * @brief 命令行选项
+ */
+struct Options {
+    bool csv;            // 输出CSV，否则输出JSON
+    const char* out;     // 输出文件，nullptr表示标准输出
+    const char* capture; // 抓包文件，nullptr表示使用合成数据
+    char delimiter;      // 帧分隔符
+    size_t frameSize;    // 合成数据的平均帧长
+    size_t totalSize;    // 合成数据的总长度
+    size_t readSize;     // frame测试中每次写入的字节数
+    int rounds;          // 每项测试的重复次数，取最快的一次
+};
+
+/**
+ * @brief 一种实现的测量结果
+ */
+struct Result {
+    const char* name;
+    double scanGBps;
+    double frameGBps;
+    size_t delimiters; // scan找到的分隔符数
+    size_t frames;     // frame取出的帧数（不含空帧）
+};
+
+void usage(const char* program) {
+    std::fprintf(stderr,
+                 "Usage: %s [--capture FILE] [--delimiter HEX] [--frame-size N] [--total-size N]\n"
+                 "          [--read N] [--rounds N] [--format json|csv] [--out FILE]\n",
+                 program);
+    std::exit(2);
+}
+
+Options parse(int argc, char** argv) {
+    Options options;
+    options.csv       = false;
+    options.out       = nullptr;
+    options.capture   = nullptr;
+    options.delimiter = '\n';
+    options.frameSize = 64;
+    options.totalSize = 64 << 20;
+    options.readSize  = 4096;
+    options.rounds    = 5;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+
+        if (i + 1 >= argc) {
+            usage(argv[0]);
+        }
+
+        const char* value = argv[++i];
+
+        if (arg == "--format") {
+            options.csv = std::strcmp(value, "csv") == 0;
+        } else if (arg == "--out") {
+            options.out = value;
+        } else if (arg == "--capture") {
+            options.capture = value;
+        } else if (arg == "--delimiter") {
+            options.delimiter = static_cast<char>(std::strtoul(value, nullptr, 16));
+        } else if (arg == "--frame-size") {
+            options.frameSize = std::strtoul(value, nullptr, 10);
+        } else if (arg == "--total-size") {
+            options.totalSize = std::strtoul(value, nullptr, 10);
+        } else if (arg == "--read") {
+            options.readSize = std::strtoul(value, nullptr, 10);
+        } else if (arg == "--rounds") {
+            options.rounds = std::atoi(value);
+        } else {
+            usage(argv[0]);
+        }
+    } /* for (int i = 1; i < argc; ++i) { */
+
+    if (options.frameSize < 2 || options.totalSize == 0 || options.readSize == 0 || options.rounds <= 0) {
+        usage(argv[0]);
+    }
+
+    return options;
+} /* Options parse(int argc, char** argv) { */
+
+/**
+ * @brief 读入抓包文件
+ */
+std::vector<char> loadCapture(const char* path) {
+    FILE* file = std::fopen(path, "rb");
+
+    if (file == nullptr) {
+        std::perror(path);
+        std::exit(1);
+    }
+
+    std::vector<char> data;
+    char chunk[65536];
+    size_t count;
+
+    while ((count = std::fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        data.insert(data.end(), chunk, chunk + count);
+    }
+
+    std::fclose(file);
+    return data;
+}
+
+/**
+ * @brief 合成数据：帧长在[frameSize/2, frameSize*3/2)内均匀分布，帧内不含分隔符
+ */
+std::vector<char> synthesize(const Options& options) {
+    std::vector<char> data(options.totalSize);
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+    size_t remain  = 0;
+
+    for (size_t i = 0; i < data.size(); ++i) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+
+        if (remain == 0) {
+            data[i] = options.delimiter;
+            remain  = options.frameSize / 2 + (state >> 33) % options.frameSize;
+            continue;
+        }
+
+        char byte = static_cast<char>(state >> 56);
+        data[i]   = byte == options.delimiter ? static_cast<char>(byte + 1) : byte;
+        --remain;
+    }
+
+    return data;
+} /* std::vector<char> synthesize(const Options& options) { */
+
+double seconds(Clock::duration elapsed) {
+    return std::chrono::duration<double>(elapsed).count();
+}
+
+/**
+ * @brief 在整段数据上查找全部分隔符
+ * @return 最快一次的GB/s
+ */
+template <typename Find>
+double measureScan(const std::vector<char>& data, char delimiter, int rounds, Find find, size_t& found) {
+    double best = 0;
+
+    for (int r = 0; r < rounds; ++r) {
+        const char* p   = data.data();
+        const char* end = p + data.size();
+        size_t count    = 0;
+
+        Clock::time_point start = Clock::now();
+
+        while ((p = find(p, end, delimiter)) != end) {
+            ++count;
+            ++p;
+        }
+
+        double rate = data.size() / seconds(Clock::now() - start) / 1e9;
+        best  = rate > best ? rate : best;
+        found = count;
+    } /* for (int r = 0; r < rounds; ++r) { */
+
+    return best;
+} /* double measureScan(...) { */
+
+/**
+ * @brief 按readSize字节一次写入UartFrameScanner并取出全部帧
+ * @return 最快一次的GB/s
+ */
+double measureFrame(const std::vector<char>& data, const Options& options, UartSimd level, size_t& frames) {
+    double best = 0;
+
+    for (int r = 0; r < options.rounds; ++r) {
+        UartFrameScanner scanner(options.delimiter, 65536, true, level);
+        size_t offset = 0;
+        size_t count  = 0;
+        UartSpan frame;
+
+        Clock::time_point start = Clock::now();
+
+        while (offset < data.size()) {
+            size_t length = data.size() - offset < options.readSize ? data.size() - offset : options.readSize;
+            offset += scanner.feed(data.data() + offset, length);
+
+            while (scanner.next(frame)) {
+                ++count;
+            }
+        }
+
+        double rate = data.size() / seconds(Clock::now() - start) / 1e9;
+        best   = rate > best ? rate : best;
+        frames = count;
+    } /* for (int r = 0; r < options.rounds; ++r) { */
+
+    return best;
+} /* double measureFrame(...) { */
+
+const char* findMemchr(const char* begin, const char* end, char value) {
+    const void* found = std::memchr(begin, value, end - begin);
+    return found == nullptr ? end : static_cast<const char*>(found);
+}
+
+void writeResults(FILE* out, const Options& options, size_t bytes, const std::vector<Result>& results) {
+    if (options.csv) {
+        std::fprintf(out, "impl,bytes,scan_gbps,frame_gbps,delimiters,frames\n");
+
+        for (size_t i = 0; i < results.size(); ++i) {
+            const Result& r = results[i];
+            std::fprintf(out, "%s,%zu,%.3f,%.3f,%zu,%zu\n",
+                         r.name, bytes, r.scanGBps, r.frameGBps, r.delimiters, r.frames);
+        }
+        return;
+    }
+
+    std::fprintf(out, "{\n  \"benchmark\": \"frame\",\n  \"source\": \"%s\",\n  \"bytes\": %zu,\n"
+                      "  \"delimiter\": %u,\n  \"read\": %zu,\n  \"results\": [\n",
+                 options.capture != nullptr ? options.capture : "synthetic", bytes,
+                 static_cast<unsigned>(static_cast<unsigned char>(options.delimiter)), options.readSize);
+
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        std::fprintf(out, "    {\"impl\": \"%s\", \"scan_gbps\": %.3f, \"frame_gbps\": %.3f, "
+                          "\"delimiters\": %zu, \"frames\": %zu}%s\n",
+                     r.name, r.scanGBps, r.frameGBps, r.delimiters, r.frames, i + 1 < results.size() ? "," : "");
+    }
+
+    std::fprintf(out, "  ]\n}\n");
+} /* void writeResults(...) { */
+
+} /* namespace { */
+
+int main(int argc, char** argv) {
+    Options options = parse(argc, argv);
+    std::vector<char> data = options.capture != nullptr ? loadCapture(options.capture) : synthesize(options);
+
+    if (data.empty()) {
+        std::fprintf(stderr, "Empty capture.\n");
+        return 1;
+    }
+
+    struct Impl {
+        const char* name;
+        UartSimd level;
+        bool supported;
+    };
+
+    UartSimd best = uartSimdLevel();
+    const Impl impls[] = {
+        {"scalar", UartSimd::Scalar, true},
+        {"sse2",   UartSimd::Sse2,   best == UartSimd::Sse2 || best == UartSimd::Avx2},
+        {"avx2",   UartSimd::Avx2,   best == UartSimd::Avx2},
+        {"neon",   UartSimd::Neon,   best == UartSimd::Neon},
+    };
+
+    std::vector<Result> results;
+
+    for (size_t i = 0; i < sizeof(impls) / sizeof(impls[0]); ++i) {
+        if (!impls[i].supported) {
+            continue;
+        }
+
+        UartSimd level = impls[i].level;
+        Result result;
+        result.name      = impls[i].name;
+        result.scanGBps  = measureScan(data, options.delimiter, options.rounds,
+                                       [level](const char* b, const char* e, char v) {
+                                           return uartFindByte(b, e, v, level);
+                                       }, result.delimiters);
+        result.frameGBps = measureFrame(data, options, level, result.frames);
+
+        results.push_back(result);
+        std::fprintf(stderr, "%s done\n", result.name);
+    } /* for (size_t i = 0; ...) { */
+
+    // memchr()只作为扫描速率的参照，不参与帧切分
+    Result libc;
+    libc.name      = "memchr";
+    libc.scanGBps  = measureScan(data, options.delimiter, options.rounds, findMemchr, libc.delimiters);
+    libc.frameGBps = 0;
+    libc.frames    = 0;
+    results.push_back(libc);
+
+    FILE* out = stdout;
+
+    if (options.out != nullptr) {
+        out = std::fopen(options.out, "w");
+
+        if (out == nullptr) {
+            std::perror(options.out);
+            return 1;
+        }
+    }
+
+    writeResults(out, options, data.size(), results);
+
+    if (out != stdout) {
+        std::fclose(out);
+    }
+
+    return 0;
+} /* int main(int argc, char** argv) { */
@@ -0,0 +1,143 @@
+/**
+ * @file move_bench.cpp
+ * @brief 在连续数组中打开并移动大量Uart的测试
+ * @note 编译：g++ -std=c++11 -O2 -I. bench/move_bench.cpp -o move_bench -lutil
+ *       打开N个（默认1000）伪终端并把Uart依次放入std::vector<Uart>（扩容时整体移动），
+ *       再把数组反转、从中间删除一半，然后检查：
+ *         每个Uart仍持有各自的文件描述符，且能通过该描述符向对应的master发送数据；
+ *         被移走的Uart不再持有文件描述符，销毁时不会关闭别人的描述符。
+ *       输出sizeof(Uart)、每次打开与每次移动的耗时（纳秒），任何检查失败时返回1。
+ *       N较大时需要相应调高kernel.pty.max与文件描述符上限（ulimit -n ≥ 2N + 100）
+ */
+
+// 标准库
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+// 第三方库
+#include <pty.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+#include "uart.hpp"
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+/**
+ * @brief 创建一个伪终端，返回master，slave路径写入path
+ */
+int openPty(char* path) {
+    int master = -1;
+    int slave  = -1;
+
+    if (openpty(&master, &slave, path, nullptr, nullptr) == -1) {
+        std::perror("openpty");
+        std::exit(1);
+    }
+
+    ::close(slave);
+    return master;
+}
+
+double nanosSince(Clock::time_point start, size_t count) {
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / count;
+}
+
+/**
+ * @brief 检查uart仍能向master发送数据
+ */
+bool roundTrip(const Uart& uart, int master, char tag) {
+    if (uart.send(&tag, 1) != 1) {
+        return false;
+    }
+
+    char c = 0;
+    return ::read(master, &c, 1) == 1 && c == tag;
+}
+
+} /* namespace { */
+
+int main(int argc, char** argv) {
+    size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000;
+
+    if (count == 0) {
+        std::fprintf(stderr, "Usage: %s [PORTS]\n", argv[0]);
+        return 2;
+    }
+
+    std::vector<int> masters;
+    std::vector<Uart> ports;
+    char path[64];
+    size_t failures = 0;
+
+    // 故意不预留容量，让扩容反复移动已有的Uart
+    Clock::time_point start = Clock::now();
+
+    for (size_t i = 0; i < count; ++i) {
+        masters.push_back(openPty(path));
+        ports.push_back(Uart(path, 115200));
+        ports.back().configRawMode(true);
+
+        if (!ports.back().open()) {
+            std::fprintf(stderr, "Error in opening %s.\n", path);
+            return 1;
+        }
+    }
+
+    double openNs = nanosSince(start, count);
+
+    // 反转与删除都通过移动赋值完成
+    start = Clock::now();
+    std::reverse(ports.begin(), ports.end());
+    std::reverse(masters.begin(), masters.end());
+    double moveNs = nanosSince(start, count);
+
+    size_t keep = count - count / 2;
+    ports.erase(ports.begin() + keep / 2, ports.begin() + keep / 2 + count / 2);
+
+    for (size_t i = keep / 2; i < keep / 2 + count / 2; ++i) {
+        ::close(masters[i]);
+    }
+
+    masters.erase(masters.begin() + keep / 2, masters.begin() + keep / 2 + count / 2);
+
+    std::vector<int> fds;
+
+    for (size_t i = 0; i < ports.size(); ++i) {
+        fds.push_back(ports[i].getFd());
+
+        if (!ports[i].isOpen() || fcntl(ports[i].getFd(), F_GETFD) == -1
+            || !roundTrip(ports[i], masters[i], static_cast<char>('a' + i % 26))) {
+            ++failures;
+        }
+    }
+
+    std::sort(fds.begin(), fds.end());
+
+    if (std::adjacent_find(fds.begin(), fds.end()) != fds.end()) {
+        ++failures;
+    }
+
+    // 移走后的对象不再持有描述符
+    Uart moved(std::move(ports.front()));
+
+    if (ports.front().getFd() != -1 || ports.front().isOpen() || !roundTrip(moved, masters.front(), 'z')) {
+        ++failures;
+    }
+
+    std::printf("{\"ports\": %zu, \"sizeof_uart\": %zu, \"open_ns\": %.0f, \"move_ns\": %.1f, \"failures\": %zu}\n",
+                count, sizeof(Uart), openNs, moveNs, failures);
+
+    for (size_t i = 0; i < masters.size(); ++i) {
+        ::close(masters[i]);
+    }
+
+    return failures == 0 ? 0 : 1;
+} /* int main(int argc, char** argv) { */
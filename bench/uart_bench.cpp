@@ -0,0 +1,1312 @@
+/**
+ * @file uart_bench.cpp
+ * @brief Uart收发性能基准测试
+ * @note 编译：g++ -std=c++11 -O2 -I. bench/uart_bench.cpp -o uart_bench -lutil -pthread
+ *       在openpty()创建的伪终端上，对configBaudRate()表中的每个波特率、1B~64KB的每种块大小，分别测量：
+ *         发送/接收吞吐（MB/s，1MB = 10^6字节）、每MB的系统调用次数、每MB消耗的进程CPU时间，
+ *         以及回环往返延迟的p50/p99/p99.9（微秒）。
+ *       百分位数至少需要1/(1-p)个样本（p99需100个，p99.9需1000个），样本不足时JSON输出null、CSV留空，
+ *         64KB等大块在--duration内达不到--iterations次往返时p99.9通常为null。
+ *       伪终端不按波特率限速，因此结果反映的是驱动与库本身的开销，而非线路速率。
+ *       结果以JSON（默认）或CSV输出，便于跨版本对比。
+ *       --registry N模式改为测量PortRegistry在N个伪终端上巡检统计与截止时间的耗时，
+ *       N较大时需要相应调高kernel.pty.max与文件描述符上限（ulimit -n ≥ 2N + 100）
+ *       --uring N模式在N个伪终端上对比UartUring批量提交与逐个read()/write()的
+ *         吞吐、每秒系统调用次数与每MB的CPU时间，块大小取--min-chunk到--max-chunk
+ *       --read-policy N模式让对端以每次8字节的小块持续写入，分别用Any、AtLeast(N)与CountOrIdle(N, 0.1s)
+ *         读取策略接收，统计每KB数据的系统调用次数与唤醒（receive()返回）次数
+ *       --poller MODE模式测量单字节从master写入到接收线程拿到数据的延迟p50/p99/p99.9，
+ *         MODE为Block（UartPoller阻塞poll()）、Epoll（epoll_wait()）、BusyPoll、Hybrid或All，采样次数为--iterations
+ *       --raw-latency N模式分别在规范模式与原始模式下，从master写入单个不带换行的字节，
+ *         测量N次Uart收到该字节的延迟；规范模式下字节要等到换行才会交付，记为超时
+ */
+
+// 标准库
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+// 第三方库
+#include <poll.h>
+#include <pty.h>
+#include <sys/epoll.h>
+#include <time.h>
+#include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
+
+#include "uart.hpp"
+#include "uart_poller.hpp"
+#include "uart_registry.hpp"
+#include "uart_uring.hpp"
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+/**
+ * @brief 命令行选项
+ */
+struct Options {
+    bool csv;           // 输出CSV，否则输出JSON
+    const char* out;    // 输出文件，nullptr表示标准输出
+    long baud;          // 只测试该波特率，0表示测试全部
+    size_t minChunk;    // 最小块大小
+    size_t maxChunk;    // 最大块大小
+    size_t chunkStep;   // 块大小的倍数
+    int durationMs;     // 每个吞吐阶段的时长
+    int iterations;     // 往返延迟的最大采样次数
+    size_t registry;    // PortRegistry巡检的串口数，0表示不运行
+    int sweeps;         // PortRegistry巡检的次数
+    size_t uring;       // io_uring对比的串口数，0表示不运行
+    int rawLatency;     // 原始模式延迟测试的采样次数，0表示不运行
+    int readPolicy;     // 读取策略对比中AtLeast/CountOrIdle的VMIN，0表示不运行
+    const char* poller; // 接收延迟对比的等待方式，nullptr表示不运行
+};
+
+/**
+ * @brief 一组参数的测量结果
+ */
+struct Result {
+    long baud;
+    size_t chunk;
+    double txMBps;
+    double txSyscallsPerMB;
+    double txCpuMsPerMB;
+    double rxMBps;
+    double rxSyscallsPerMB;
+    double rxCpuMsPerMB;
+    double rttP50Us;
+    double rttP99Us;
+    double rttP999Us;
+    size_t rttSamples;
+};
+
+/**
+ * @brief PortRegistry巡检的测量结果（每个串口的平均耗时）
+ */
+struct RegistryResult {
+    size_t ports;
+    double receiveNsPerPort;
+    double totalsNsPerPort;
+    double expireNsPerPort;
+    size_t expired;
+};
+
+/**
+ * @brief io_uring与read()/write()对比的一组测量结果
+ */
+struct UringResult {
+    const char* backend; // "uring"或"readwrite"
+    size_t ports;
+    size_t chunk;
+    double txMBps;
+    double txSyscallsPerSec;
+    double txCpuMsPerMB;
+    double rxMBps;
+    double rxSyscallsPerSec;
+    double rxCpuMsPerMB;
+};
+
+/**
+ * @brief 一种读取策略的测量结果
+ */
+struct ReadPolicyResult {
+    const char* policy;    // "Any"、"AtLeast"或"CountOrIdle"
+    uint64_t bytes;        // 接收的字节数
+    double syscallsPerKB;  // 每KB的read()/poll()次数
+    double wakeupsPerKB;   // 每KB的唤醒（一次等待或读取返回）次数
+    double bytesPerRead;   // 平均每次read()读到的字节数
+};
+
+/**
+ * @brief 一种等待方式的接收延迟
+ */
+struct PollerResult {
+    const char* mode;
+    double p50Us;
+    double p99Us;
+    double p999Us;
+    size_t samples;
+};
+
+/**
+ * @brief 单字节交付延迟的测量结果
+ */
+struct RawLatencyResult {
+    const char* mode; // "cooked"或"raw"
+    double p50Us;
+    double p99Us;
+    double maxUs;
+    size_t delivered; // 在超时之前收到的次数
+    size_t timeouts;  // 超时的次数
+};
+
+double processCpuSeconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+void waitFd(int fd, short events) {
+    struct pollfd pfd;
+    pfd.fd     = fd;
+    pfd.events = events;
+    ::poll(&pfd, 1, 100);
+}
+
+/**
+ * @brief 伪终端上的被测串口，master为模拟外设的一端（阻塞）
+ */
+struct Bench {
+    int master;
+    Uart uart;
+
+    Bench(const char* path, long baud, int masterFd)
+        : master(masterFd)
+        , uart(path, static_cast<speed_t>(baud)) {
+            uart.configRawMode(true);
+
+            if (!uart.open()) {
+                std::fprintf(stderr, "Error in opening %s.\n", path);
+                std::exit(1);
+            }
+        }
+
+    ~Bench() {
+        ::close(master);
+    }
+};
+
+/**
+ * @brief 打开一个伪终端，并将主设备端设为原始模式
+ */
+int openPty(std::string& path) {
+    int master;
+    int slave;
+    char name[64];
+
+    if (openpty(&master, &slave, name, nullptr, nullptr) == -1) {
+        std::perror("openpty");
+        std::exit(1);
+    }
+
+    struct termios tty;
+    tcgetattr(master, &tty);
+    cfmakeraw(&tty);
+    tcsetattr(master, TCSANOW, &tty);
+
+    ::close(slave);
+    path = name;
+    return master;
+}
+
+/**
+ * @brief 发送吞吐：Uart用trySend()发送，另一线程从master读走
+ */
+void measureTx(Bench& bench, size_t chunk, int durationMs, Result& result) {
+    std::vector<char> data(chunk, 0x5a);
+    std::atomic<uint64_t> target(UINT64_MAX);
+
+    std::thread reader([&bench, &target]() {
+        std::vector<char> buffer(65536);
+        uint64_t received = 0;
+
+        while (received < target.load()) {
+            struct pollfd pfd;
+            pfd.fd     = bench.master;
+            pfd.events = POLLIN;
+
+            if (::poll(&pfd, 1, 10) > 0) {
+                ssize_t n = ::read(bench.master, buffer.data(), buffer.size());
+                received += n > 0 ? static_cast<uint64_t>(n) : 0;
+            }
+        }
+    });
+
+    uint64_t sent     = 0;
+    uint64_t syscalls = 0;
+    double cpu        = processCpuSeconds();
+    Clock::time_point start = Clock::now();
+    Clock::time_point end   = start + std::chrono::milliseconds(durationMs);
+
+    while (Clock::now() < end) {
+        size_t offset = 0;
+
+        while (offset < chunk) {
+            UartResult r = bench.uart.trySend(data.data() + offset, chunk - offset);
+            syscalls += 1;
+
+            if (r.has_value()) {
+                offset += *r;
+            } else {
+                waitFd(bench.uart.getFd(), POLLOUT);
+                syscalls += 1;
+            }
+        }
+
+        sent += chunk;
+    } /* while (Clock::now() < end) { */
+
+    target.store(sent);
+    reader.join();
+
+    double seconds = secondsSince(start);
+    double mb      = sent / 1e6;
+
+    result.txMBps          = mb / seconds;
+    result.txSyscallsPerMB = syscalls / mb;
+    result.txCpuMsPerMB    = (processCpuSeconds() - cpu) * 1e3 / mb;
+} /* void measureTx(Bench& bench, size_t chunk, int durationMs, Result& result) { */
+
+/**
+ * @brief 接收吞吐：另一线程向master写入，Uart用tryReceive()读取
+ */
+void measureRx(Bench& bench, size_t chunk, int durationMs, Result& result) {
+    std::atomic<bool> stop(false);
+    std::atomic<bool> done(false);
+    std::atomic<uint64_t> written(0);
+
+    std::thread writer([&bench, &stop, &done, &written, chunk]() {
+        std::vector<char> data(chunk, 0x5a);
+
+        while (!stop.load()) {
+            ssize_t n = ::write(bench.master, data.data(), chunk);
+
+            if (n > 0) {
+                written.fetch_add(static_cast<uint64_t>(n));
+            }
+        }
+
+        done.store(true);
+    });
+
+    std::vector<char> buffer(chunk);
+    uint64_t received = 0;
+    uint64_t syscalls = 0;
+    double cpu        = processCpuSeconds();
+    Clock::time_point start = Clock::now();
+    Clock::time_point end   = start + std::chrono::milliseconds(durationMs);
+
+    while (!done.load() || received < written.load()) {
+        if (!stop.load() && Clock::now() >= end) {
+            stop.store(true);
+        }
+
+        UartResult r = bench.uart.tryReceive(buffer.data(), chunk);
+        syscalls += 1;
+
+        if (r.has_value()) {
+            received += *r;
+        } else {
+            waitFd(bench.uart.getFd(), POLLIN);
+            syscalls += 1;
+        }
+    } /* while (!done.load() || received < written.load()) { */
+
+    writer.join();
+
+    double seconds = secondsSince(start);
+    double mb      = received / 1e6;
+
+    result.rxMBps          = mb / seconds;
+    result.rxSyscallsPerMB = syscalls / mb;
+    result.rxCpuMsPerMB    = (processCpuSeconds() - cpu) * 1e3 / mb;
+} /* void measureRx(Bench& bench, size_t chunk, int durationMs, Result& result) { */
+
+/**
+ * @brief 已排序样本的百分位数，样本数不足1/(1-p)时该百分位数只是最大值，返回NaN
+ */
+double percentile(const std::vector<double>& samples, double p) {
+    if ((1 - p) * samples.size() < 1) {
+        return NAN;
+    }
+
+    size_t index = static_cast<size_t>(p * samples.size());
+    return samples[index < samples.size() ? index : samples.size() - 1];
+}
+
+/**
+ * @brief 格式化延迟（微秒），NaN在JSON中输出为null，在CSV中留空
+ */
+std::string formatUs(double us, bool csv) {
+    if (std::isnan(us)) {
+        return csv ? "" : "null";
+    }
+
+    char text[32];
+    std::snprintf(text, sizeof(text), "%.2f", us);
+    return text;
+}
+
+/**
+ * @brief 往返延迟：Uart发送一块，另一线程在master上原样回送，Uart收齐后计时
+ */
+void measureRtt(Bench& bench, size_t chunk, int durationMs, int iterations, Result& result) {
+    std::atomic<bool> stop(false);
+
+    std::thread echo([&bench, &stop, chunk]() {
+        std::vector<char> buffer(chunk);
+
+        for (;;) {
+            size_t got = 0;
+
+            while (got < chunk) {
+                struct pollfd pfd;
+                pfd.fd     = bench.master;
+                pfd.events = POLLIN;
+
+                if (::poll(&pfd, 1, 10) <= 0) {
+                    if (stop.load() && got == 0) {
+                        return;
+                    }
+                    continue;
+                }
+
+                ssize_t n = ::read(bench.master, buffer.data() + got, chunk - got);
+                got += n > 0 ? static_cast<size_t>(n) : 0;
+            } /* while (got < chunk) { */
+
+            size_t put = 0;
+
+            while (put < chunk) {
+                ssize_t n = ::write(bench.master, buffer.data() + put, chunk - put);
+                put += n > 0 ? static_cast<size_t>(n) : 0;
+            }
+        } /* for (;;) { */
+    });
+
+    std::vector<char> data(chunk, 0x5a);
+    std::vector<char> buffer(chunk);
+    std::vector<double> samples;
+    Clock::time_point end = Clock::now() + std::chrono::milliseconds(durationMs);
+
+    samples.reserve(iterations);
+
+    for (int i = 0; i < iterations && (i == 0 || Clock::now() < end); ++i) {
+        Clock::time_point start = Clock::now();
+        size_t offset = 0;
+
+        while (offset < chunk) {
+            UartResult r = bench.uart.trySend(data.data() + offset, chunk - offset);
+
+            if (r.has_value()) {
+                offset += *r;
+            } else {
+                waitFd(bench.uart.getFd(), POLLOUT);
+            }
+        }
+
+        UartProgress progress = bench.uart.receiveExact(buffer.data(), chunk, start + std::chrono::seconds(5));
+
+        if (!progress.done()) {
+            std::fprintf(stderr, "Round trip failed: %s\n", progress.error.message().c_str());
+            std::exit(1);
+        }
+
+        samples.push_back(std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+    } /* for (int i = 0; ...) { */
+
+    stop.store(true);
+    echo.join();
+
+    std::sort(samples.begin(), samples.end());
+    result.rttP50Us   = percentile(samples, 0.50);
+    result.rttP99Us   = percentile(samples, 0.99);
+    result.rttP999Us  = percentile(samples, 0.999);
+    result.rttSamples = samples.size();
+} /* void measureRtt(Bench& bench, size_t chunk, ...) { */
+
+/**
+ * @brief PortRegistry巡检：N个串口中一半有数据，全部读一遍、汇总统计、处理截止时间
+ */
+RegistryResult measureRegistry(size_t ports, int sweeps) {
+    std::vector<int> masters;
+    PortRegistry registry;
+    std::vector<PortHandle> handles;
+
+    masters.reserve(ports);
+    handles.reserve(ports);
+    registry.reserve(ports);
+
+    for (size_t i = 0; i < ports; ++i) {
+        std::string path;
+        masters.push_back(openPty(path));
+
+        Uart uart(path.c_str(), 115200);
+        uart.configRawMode(true);
+
+        if (!uart.open()) {
+            std::fprintf(stderr, "Error in opening %s.\n", path.c_str());
+            std::exit(1);
+        }
+
+        handles.push_back(registry.add(std::move(uart)));
+    } /* for (size_t i = 0; i < ports; ++i) { */
+
+    RegistryResult result;
+    result.ports   = ports;
+    result.expired = 0;
+
+    double receiveNs = 0;
+    double totalsNs  = 0;
+    double expireNs  = 0;
+    uint64_t sink    = 0;
+
+    for (int s = 0; s < sweeps; ++s) {
+        for (size_t i = 0; i < ports; i += 2) {
+            ssize_t n = ::write(masters[i], "x", 1);
+            (void)n;
+        }
+
+        // 等待数据经过伪终端
+        usleep(20000);
+
+        Clock::time_point start = Clock::now();
+        char buffer[64];
+
+        for (size_t i = 0; i < handles.size(); ++i) {
+            UartResult r = registry.receive(handles[i], buffer, sizeof(buffer));
+            sink += r.has_value() ? *r : 0;
+        }
+
+        receiveNs += std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+        start = Clock::now();
+        sink += registry.getTotals().rxBytes;
+        totalsNs += std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+        Clock::time_point now = Clock::now();
+
+        for (size_t i = 0; i < handles.size(); i += 3) {
+            registry.setDeadline(handles[i], now);
+        }
+
+        start = Clock::now();
+        result.expired += registry.expire(now, [&sink](PortHandle handle) { sink += handle.index; });
+        expireNs += std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    } /* for (int s = 0; s < sweeps; ++s) { */
+
+    for (size_t i = 0; i < masters.size(); ++i) {
+        ::close(masters[i]);
+    }
+
+    result.receiveNsPerPort = receiveNs / sweeps / ports;
+    result.totalsNsPerPort  = totalsNs / sweeps / ports;
+    result.expireNsPerPort  = expireNs / sweeps / ports;
+
+    if (sink == 0) {
+        std::fprintf(stderr, "No data received.\n");
+    }
+
+    return result;
+} /* RegistryResult measureRegistry(size_t ports, int sweeps) { */
+
+/**
+ * @brief 一组伪终端，master端设为非阻塞，由对端线程轮流读写
+ */
+struct PtyGroup {
+    std::vector<int> masters;
+    std::vector<Uart> uarts;
+
+    explicit PtyGroup(size_t ports) {
+        masters.reserve(ports);
+        uarts.reserve(ports);
+
+        for (size_t i = 0; i < ports; ++i) {
+            std::string path;
+            int master = openPty(path);
+            fcntl(master, F_SETFL, fcntl(master, F_GETFL) | O_NONBLOCK);
+            masters.push_back(master);
+
+            uarts.push_back(Uart(path.c_str(), 115200));
+            uarts.back().configRawMode(true);
+
+            if (!uarts.back().open()) {
+                std::fprintf(stderr, "Error in opening %s.\n", path.c_str());
+                std::exit(1);
+            }
+        } /* for (size_t i = 0; i < ports; ++i) { */
+    }
+
+    ~PtyGroup() {
+        for (size_t i = 0; i < masters.size(); ++i) {
+            ::close(masters[i]);
+        }
+    }
+};
+
+/**
+ * @brief 对端线程：不断读走所有master上的数据，直到stop
+ */
+void drainMasters(const PtyGroup& group, const std::atomic<bool>& stop) {
+    std::vector<char> buffer(65536);
+
+    while (!stop.load()) {
+        bool idle = true;
+
+        for (size_t i = 0; i < group.masters.size(); ++i) {
+            while (::read(group.masters[i], buffer.data(), buffer.size()) > 0) {
+                idle = false;
+            }
+        }
+
+        if (idle) {
+            usleep(50);
+        }
+    } /* while (!stop.load()) { */
+}
+
+/**
+ * @brief 对端线程：轮流向所有master写入，写满时跳过，直到stop
+ */
+void feedMasters(const PtyGroup& group, size_t chunk, const std::atomic<bool>& stop) {
+    std::vector<char> data(chunk, 0x5a);
+
+    while (!stop.load()) {
+        bool idle = true;
+
+        for (size_t i = 0; i < group.masters.size(); ++i) {
+            if (::write(group.masters[i], data.data(), chunk) > 0) {
+                idle = false;
+            }
+        }
+
+        if (idle) {
+            usleep(50);
+        }
+    } /* while (!stop.load()) { */
+}
+
+/**
+ * @brief 发送：每个串口每轮发送一块。uring为每轮一次submit()，readwrite为每个串口一次trySend()
+ */
+void measureUringTx(PtyGroup& group, bool uring, size_t chunk, int durationMs, UringResult& result) {
+    std::atomic<bool> stop(false);
+    std::thread peer(drainMasters, std::cref(group), std::cref(stop));
+
+    size_t ports = group.uarts.size();
+    std::vector<char> data(chunk, 0x5a);
+    UartUring ring(static_cast<unsigned>(ports));
+    uint64_t sent     = 0;
+    uint64_t syscalls = 0;
+    double cpu        = processCpuSeconds();
+    Clock::time_point start = Clock::now();
+    Clock::time_point end   = start + std::chrono::milliseconds(durationMs);
+
+    while (Clock::now() < end) {
+        if (uring) {
+            for (size_t i = 0; i < ports; ++i) {
+                ring.prepareWrite(group.uarts[i], data.data(), static_cast<unsigned>(chunk), i);
+            }
+
+            ring.submit(static_cast<unsigned>(ports));
+            syscalls += 1;
+            ring.reap([&sent](const UartCompletion& c) {
+                sent += c.result > 0 ? static_cast<uint64_t>(c.result) : 0;
+            });
+            continue;
+        } /* if (uring) { */
+
+        for (size_t i = 0; i < ports; ++i) {
+            UartResult r = group.uarts[i].trySend(data.data(), chunk);
+            sent     += r.has_value() ? *r : 0;
+            syscalls += 1;
+        }
+    } /* while (Clock::now() < end) { */
+
+    double seconds = secondsSince(start);
+    double mb      = sent / 1e6;
+
+    result.txMBps           = mb / seconds;
+    result.txSyscallsPerSec = syscalls / seconds;
+    result.txCpuMsPerMB     = (processCpuSeconds() - cpu) * 1e3 / mb;
+
+    stop.store(true);
+    peer.join();
+} /* void measureUringTx(...) { */
+
+/**
+ * @brief 接收：每个串口保持一个读请求。uring为每轮一次submit()，readwrite为一次poll()加每个就绪串口一次tryReceive()
+ */
+void measureUringRx(PtyGroup& group, bool uring, size_t chunk, int durationMs, UringResult& result) {
+    std::atomic<bool> stop(false);
+    std::thread peer(feedMasters, std::cref(group), chunk, std::cref(stop));
+
+    size_t ports = group.uarts.size();
+    std::vector<char> buffer(ports * chunk);
+    std::vector<struct pollfd> fds(ports);
+    UartUring ring(static_cast<unsigned>(ports));
+    size_t outstanding = 0;
+    uint64_t received  = 0;
+    uint64_t syscalls  = 0;
+    double cpu         = processCpuSeconds();
+    Clock::time_point start = Clock::now();
+    Clock::time_point end   = start + std::chrono::milliseconds(durationMs);
+
+    for (size_t i = 0; i < ports; ++i) {
+        fds[i].fd     = group.uarts[i].getFd();
+        fds[i].events = POLLIN;
+    }
+
+    if (uring) {
+        for (size_t i = 0; i < ports; ++i) {
+            ring.prepareRead(group.uarts[i], buffer.data() + i * chunk, static_cast<unsigned>(chunk), i);
+        }
+        outstanding = ports;
+    }
+
+    // uring：截止后不再补充读请求，已提交的请求由仍在写入的对端完成
+    while (Clock::now() < end || outstanding > 0) {
+        if (!uring) {
+            syscalls += 1;
+
+            if (::poll(fds.data(), fds.size(), 100) <= 0) {
+                continue;
+            }
+
+            for (size_t i = 0; i < ports; ++i) {
+                if (fds[i].revents & POLLIN) {
+                    UartResult r = group.uarts[i].tryReceive(buffer.data() + i * chunk, chunk);
+                    received += r.has_value() ? *r : 0;
+                    syscalls += 1;
+                }
+            }
+            continue;
+        } /* if (!uring) { */
+
+        ring.submit(1);
+        syscalls += 1;
+
+        bool refill = Clock::now() < end;
+        ring.reap([&](const UartCompletion& c) {
+            received += c.result > 0 ? static_cast<uint64_t>(c.result) : 0;
+
+            if (refill) {
+                ring.prepareRead(group.uarts[c.userData], buffer.data() + c.userData * chunk,
+                                 static_cast<unsigned>(chunk), c.userData);
+            } else {
+                --outstanding;
+            }
+        });
+    } /* while (Clock::now() < end || outstanding > 0) { */
+
+    double seconds = secondsSince(start);
+    double mb      = received / 1e6;
+
+    result.rxMBps           = mb / seconds;
+    result.rxSyscallsPerSec = syscalls / seconds;
+    result.rxCpuMsPerMB     = (processCpuSeconds() - cpu) * 1e3 / mb;
+
+    stop.store(true);
+    peer.join();
+} /* void measureUringRx(...) { */
+
+/**
+ * @brief 读取策略：对端每50微秒写入8字节，持续durationMs；Uart按策略循环receive()直到读完
+ * @note Any策略用tryReceive()加poll()等待；阻塞策略的读取超时为100ms，写端结束后以超时判断读完
+ */
+ReadPolicyResult measureReadPolicy(Uart::ReadPolicy policy, int count, int durationMs) {
+    std::string path;
+    int master = openPty(path);
+    Bench bench(path.c_str(), 115200, master);
+
+    bench.uart.setReadPolicy(policy, static_cast<cc_t>(count), 1, 100);
+
+    std::atomic<bool> done(false);
+    std::atomic<uint64_t> written(0);
+
+    std::thread writer([&bench, &done, &written, count, durationMs]() {
+        const char data[8] = {0x5a, 0x5a, 0x5a, 0x5a, 0x5a, 0x5a, 0x5a, 0x5a};
+        Clock::time_point end = Clock::now() + std::chrono::milliseconds(durationMs);
+
+        while (Clock::now() < end) {
+            ssize_t n = ::write(bench.master, data, sizeof(data));
+            written.fetch_add(n > 0 ? static_cast<uint64_t>(n) : 0);
+            usleep(50);
+        }
+
+        // AtLeast策略的read()要攒满VMIN个字节才返回，总量补齐为count的整数倍
+        while (written.load() % count != 0) {
+            ssize_t n = ::write(bench.master, data, 1);
+            written.fetch_add(n > 0 ? static_cast<uint64_t>(n) : 0);
+        }
+
+        done.store(true);
+    });
+
+    std::vector<char> buffer(4096);
+    uint64_t received = 0;
+    uint64_t syscalls = 0;
+    uint64_t wakeups  = 0;
+    uint64_t reads    = 0;
+
+    while (!done.load() || received < written.load()) {
+        if (policy == Uart::ReadPolicy::Any) {
+            UartResult r = bench.uart.tryReceive(buffer.data(), buffer.size());
+            syscalls += 1;
+            wakeups  += 1;
+
+            if (r.has_value()) {
+                received += *r;
+                reads    += 1;
+            } else {
+                waitFd(bench.uart.getFd(), POLLIN);
+                syscalls += 1;
+            }
+            continue;
+        } /* if (policy == Uart::ReadPolicy::Any) { */
+
+        // receive()先poll()等待首个字节，再进行一次阻塞read()
+        ssize_t n = bench.uart.receive(buffer.data(), buffer.size() - 1);
+        syscalls += n > 0 ? 2 : 1;
+        wakeups  += 1;
+
+        if (n > 0) {
+            received += static_cast<uint64_t>(n);
+            reads    += 1;
+        }
+    } /* while (!done.load() || received < written.load()) { */
+
+    writer.join();
+
+    ReadPolicyResult result;
+    result.policy        = policy == Uart::ReadPolicy::Any ? "Any"
+                         : policy == Uart::ReadPolicy::AtLeast ? "AtLeast" : "CountOrIdle";
+    result.bytes         = received;
+    result.syscallsPerKB = syscalls * 1024.0 / received;
+    result.wakeupsPerKB  = wakeups * 1024.0 / received;
+    result.bytesPerRead  = reads > 0 ? static_cast<double>(received) / reads : 0;
+
+    return result;
+} /* ReadPolicyResult measureReadPolicy(Uart::ReadPolicy policy, int count, int durationMs) { */
+
+/**
+ * @brief 接收延迟：对端线程每隔100~300微秒写入1个字节，记录写入前的时间，
+ *        接收线程按指定方式等到数据后计算延迟，确认后对端才写下一个字节
+ * @note BusyPoll在多核机器上绑定到最后一个CPU，绑定失败时照常运行
+ */
+PollerResult measurePoller(const char* mode, int samples) {
+    std::string path;
+    int master = openPty(path);
+    Bench bench(path.c_str(), 115200, master);
+
+    bool epoll = std::strcmp(mode, "Epoll") == 0;
+    UartPoller::Mode pollerMode = std::strcmp(mode, "BusyPoll") == 0 ? UartPoller::Mode::BusyPoll
+                                : std::strcmp(mode, "Hybrid") == 0   ? UartPoller::Mode::Hybrid
+                                : UartPoller::Mode::Block;
+    UartPoller poller(bench.uart, pollerMode);
+
+    std::atomic<int64_t> sentAt(0);
+    std::atomic<int> acked(0);
+
+    std::thread writer([&bench, &sentAt, &acked, samples]() {
+        unsigned seed = 1;
+
+        for (int i = 0; i < samples; ++i) {
+            usleep(100 + rand_r(&seed) % 200);
+            sentAt.store(Clock::now().time_since_epoch().count());
+
+            ssize_t n = ::write(bench.master, "x", 1);
+            (void)n;
+
+            while (acked.load() <= i) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    if (pollerMode == UartPoller::Mode::BusyPoll && std::thread::hardware_concurrency() > 1) {
+        try {
+            UartPoller::pinCurrentThread(static_cast<int>(std::thread::hardware_concurrency()) - 1);
+        } catch (const std::runtime_error&) {
+        }
+    }
+
+    int epfd = -1;
+
+    if (epoll) {
+        struct epoll_event ev;
+        ev.events  = EPOLLIN;
+        ev.data.fd = bench.uart.getFd();
+        epfd = epoll_create1(EPOLL_CLOEXEC);
+        epoll_ctl(epfd, EPOLL_CTL_ADD, bench.uart.getFd(), &ev);
+    }
+
+    std::vector<double> latencies;
+    char buffer[64];
+
+    latencies.reserve(samples);
+
+    for (int i = 0; i < samples; ++i) {
+        size_t n = 0;
+
+        if (epoll) {
+            while (n == 0) {
+                struct epoll_event ev;
+
+                if (epoll_wait(epfd, &ev, 1, 1000) > 0) {
+                    UartResult r = bench.uart.tryReceive(buffer, sizeof(buffer));
+                    n = r.has_value() ? *r : 0;
+                }
+            }
+        } else {
+            while (n == 0) {
+                n = poller.receive(buffer, sizeof(buffer), 1000);
+            }
+        }
+
+        Clock::time_point now = Clock::now();
+        latencies.push_back(std::chrono::duration<double, std::micro>(
+            now - Clock::time_point(Clock::duration(sentAt.load()))).count());
+        acked.store(i + 1);
+    } /* for (int i = 0; i < samples; ++i) { */
+
+    writer.join();
+
+    if (epfd != -1) {
+        ::close(epfd);
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+
+    PollerResult result;
+    result.mode    = mode;
+    result.p50Us   = percentile(latencies, 0.50);
+    result.p99Us   = percentile(latencies, 0.99);
+    result.p999Us  = percentile(latencies, 0.999);
+    result.samples = latencies.size();
+
+    return result;
+} /* PollerResult measurePoller(const char* mode, int samples) { */
+
+/**
+ * @brief 单字节交付延迟：master写入一个不带换行的字节，Uart用receiveFor()等待，超时为timeoutMs
+ * @note 规范模式下超时后补发换行，使行缓冲中的数据交付并读走，不影响下一次采样
+ */
+RawLatencyResult measureRawLatency(bool raw, int samples, int timeoutMs) {
+    std::string path;
+    int master = openPty(path);
+
+    // 伪终端主从两端共用一份termios，openPty()已将其设为原始模式，这里恢复行缓冲（不回显）作为规范模式的基线
+    struct termios tty;
+    tcgetattr(master, &tty);
+    tty.c_lflag |= ICANON;
+    tcsetattr(master, TCSANOW, &tty);
+
+    Uart uart(path.c_str(), 115200);
+    uart.configRawMode(raw);
+
+    if (!uart.open()) {
+        std::fprintf(stderr, "Error in opening %s.\n", path.c_str());
+        std::exit(1);
+    }
+
+    RawLatencyResult result;
+    result.mode      = raw ? "raw" : "cooked";
+    result.delivered = 0;
+    result.timeouts  = 0;
+
+    std::vector<double> latencies;
+    char buffer[256];
+
+    latencies.reserve(samples);
+
+    for (int i = 0; i < samples; ++i) {
+        Clock::time_point start = Clock::now();
+        ssize_t n = ::write(master, "x", 1);
+        (void)n;
+
+        UartProgress progress = uart.receiveFor(buffer, sizeof(buffer), std::chrono::milliseconds(timeoutMs));
+
+        if (progress.bytes > 0) {
+            latencies.push_back(std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+            result.delivered += 1;
+            continue;
+        }
+
+        result.timeouts += 1;
+        n = ::write(master, "\n", 1);
+        uart.receiveFor(buffer, sizeof(buffer), std::chrono::milliseconds(timeoutMs));
+    } /* for (int i = 0; i < samples; ++i) { */
+
+    ::close(master);
+
+    std::sort(latencies.begin(), latencies.end());
+    result.p50Us = percentile(latencies, 0.50);
+    result.p99Us = percentile(latencies, 0.99);
+    result.maxUs = latencies.empty() ? 0 : latencies.back();
+
+    return result;
+} /* RawLatencyResult measureRawLatency(bool raw, int samples, int timeoutMs) { */
+
+void usage(const char* program) {
+    std::fprintf(stderr,
+                 "Usage: %s [--format json|csv] [--out FILE] [--baud RATE]\n"
+                 "          [--min-chunk N] [--max-chunk N] [--chunk-step N]\n"
+                 "          [--duration MS] [--iterations N] [--registry PORTS] [--sweeps N]\n"
+                 "          [--uring PORTS] [--raw-latency SAMPLES] [--read-policy VMIN]\n"
+                 "          [--poller Block|Epoll|BusyPoll|Hybrid|All]\n",
+                 program);
+    std::exit(2);
+}
+
+Options parse(int argc, char** argv) {
+    Options options;
+    options.csv        = false;
+    options.out        = nullptr;
+    options.baud       = 0;
+    options.minChunk   = 1;
+    options.maxChunk   = 65536;
+    options.chunkStep  = 4;
+    options.durationMs = 50;
+    options.iterations = 1000;
+    options.registry   = 0;
+    options.sweeps     = 10;
+    options.uring      = 0;
+    options.rawLatency = 0;
+    options.readPolicy = 0;
+    options.poller     = nullptr;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+
+        if (i + 1 >= argc) {
+            usage(argv[0]);
+        }
+
+        const char* value = argv[++i];
+
+        if (arg == "--format") {
+            options.csv = std::strcmp(value, "csv") == 0;
+        } else if (arg == "--out") {
+            options.out = value;
+        } else if (arg == "--baud") {
+            options.baud = std::atol(value);
+        } else if (arg == "--min-chunk") {
+            options.minChunk = std::strtoul(value, nullptr, 10);
+        } else if (arg == "--max-chunk") {
+            options.maxChunk = std::strtoul(value, nullptr, 10);
+        } else if (arg == "--chunk-step") {
+            options.chunkStep = std::strtoul(value, nullptr, 10);
+        } else if (arg == "--duration") {
+            options.durationMs = std::atoi(value);
+        } else if (arg == "--iterations") {
+            options.iterations = std::atoi(value);
+        } else if (arg == "--registry") {
+            options.registry = std::strtoul(value, nullptr, 10);
+        } else if (arg == "--sweeps") {
+            options.sweeps = std::atoi(value);
+        } else if (arg == "--uring") {
+            options.uring = std::strtoul(value, nullptr, 10);
+        } else if (arg == "--raw-latency") {
+            options.rawLatency = std::atoi(value);
+        } else if (arg == "--read-policy") {
+            options.readPolicy = std::atoi(value);
+        } else if (arg == "--poller") {
+            options.poller = value;
+        } else {
+            usage(argv[0]);
+        }
+    } /* for (int i = 1; i < argc; ++i) { */
+
+    if (options.poller != nullptr && std::strcmp(options.poller, "Block") != 0
+        && std::strcmp(options.poller, "Epoll") != 0 && std::strcmp(options.poller, "BusyPoll") != 0
+        && std::strcmp(options.poller, "Hybrid") != 0 && std::strcmp(options.poller, "All") != 0) {
+        usage(argv[0]);
+    }
+
+    if (options.readPolicy < 0 || options.readPolicy > 255) {
+        usage(argv[0]);
+    }
+
+    if (options.minChunk == 0 || options.maxChunk < options.minChunk || options.chunkStep < 2
+        || options.durationMs <= 0 || options.iterations <= 0 || options.sweeps <= 0) {
+        usage(argv[0]);
+    }
+
+    return options;
+} /* Options parse(int argc, char** argv) { */
+
+void writeResults(FILE* out, const Options& options, const std::vector<Result>& results) {
+    if (options.csv) {
+        std::fprintf(out, "baud,chunk,tx_mbps,tx_syscalls_per_mb,tx_cpu_ms_per_mb,"
+                          "rx_mbps,rx_syscalls_per_mb,rx_cpu_ms_per_mb,"
+                          "rtt_p50_us,rtt_p99_us,rtt_p999_us,rtt_samples\n");
+
+        for (size_t i = 0; i < results.size(); ++i) {
+            const Result& r = results[i];
+            std::fprintf(out, "%ld,%zu,%.3f,%.1f,%.3f,%.3f,%.1f,%.3f,%s,%s,%s,%zu\n",
+                         r.baud, r.chunk, r.txMBps, r.txSyscallsPerMB, r.txCpuMsPerMB,
+                         r.rxMBps, r.rxSyscallsPerMB, r.rxCpuMsPerMB,
+                         formatUs(r.rttP50Us, true).c_str(), formatUs(r.rttP99Us, true).c_str(),
+                         formatUs(r.rttP999Us, true).c_str(), r.rttSamples);
+        }
+        return;
+    } /* if (options.csv) { */
+
+    std::fprintf(out, "{\n  \"benchmark\": \"uart\",\n  \"transport\": \"pty\",\n  \"results\": [\n");
+
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        std::fprintf(out,
+                     "    {\"baud\": %ld, \"chunk\": %zu, "
+                     "\"tx_mbps\": %.3f, \"tx_syscalls_per_mb\": %.1f, \"tx_cpu_ms_per_mb\": %.3f, "
+                     "\"rx_mbps\": %.3f, \"rx_syscalls_per_mb\": %.1f, \"rx_cpu_ms_per_mb\": %.3f, "
+                     "\"rtt_p50_us\": %s, \"rtt_p99_us\": %s, \"rtt_p999_us\": %s, \"rtt_samples\": %zu}%s\n",
+                     r.baud, r.chunk, r.txMBps, r.txSyscallsPerMB, r.txCpuMsPerMB,
+                     r.rxMBps, r.rxSyscallsPerMB, r.rxCpuMsPerMB,
+                     formatUs(r.rttP50Us, false).c_str(), formatUs(r.rttP99Us, false).c_str(),
+                     formatUs(r.rttP999Us, false).c_str(), r.rttSamples,
+                     i + 1 < results.size() ? "," : "");
+    }
+
+    std::fprintf(out, "  ]\n}\n");
+} /* void writeResults(FILE* out, const Options& options, const std::vector<Result>& results) { */
+
+void writeRegistry(FILE* out, const Options& options, const RegistryResult& r) {
+    if (options.csv) {
+        std::fprintf(out, "ports,receive_ns_per_port,totals_ns_per_port,expire_ns_per_port,expired\n");
+        std::fprintf(out, "%zu,%.2f,%.3f,%.3f,%zu\n",
+                     r.ports, r.receiveNsPerPort, r.totalsNsPerPort, r.expireNsPerPort, r.expired);
+        return;
+    }
+
+    std::fprintf(out,
+                 "{\n  \"benchmark\": \"registry\",\n  \"ports\": %zu,\n"
+                 "  \"receive_ns_per_port\": %.2f,\n  \"totals_ns_per_port\": %.3f,\n"
+                 "  \"expire_ns_per_port\": %.3f,\n  \"expired\": %zu\n}\n",
+                 r.ports, r.receiveNsPerPort, r.totalsNsPerPort, r.expireNsPerPort, r.expired);
+}
+
+void writeUring(FILE* out, const Options& options, const std::vector<UringResult>& results) {
+    if (options.csv) {
+        std::fprintf(out, "backend,ports,chunk,tx_mbps,tx_syscalls_per_sec,tx_cpu_ms_per_mb,"
+                          "rx_mbps,rx_syscalls_per_sec,rx_cpu_ms_per_mb\n");
+
+        for (size_t i = 0; i < results.size(); ++i) {
+            const UringResult& r = results[i];
+            std::fprintf(out, "%s,%zu,%zu,%.3f,%.0f,%.3f,%.3f,%.0f,%.3f\n",
+                         r.backend, r.ports, r.chunk, r.txMBps, r.txSyscallsPerSec, r.txCpuMsPerMB,
+                         r.rxMBps, r.rxSyscallsPerSec, r.rxCpuMsPerMB);
+        }
+        return;
+    } /* if (options.csv) { */
+
+    std::fprintf(out, "{\n  \"benchmark\": \"uring\",\n  \"transport\": \"pty\",\n  \"results\": [\n");
+
+    for (size_t i = 0; i < results.size(); ++i) {
+        const UringResult& r = results[i];
+        std::fprintf(out,
+                     "    {\"backend\": \"%s\", \"ports\": %zu, \"chunk\": %zu, "
+                     "\"tx_mbps\": %.3f, \"tx_syscalls_per_sec\": %.0f, \"tx_cpu_ms_per_mb\": %.3f, "
+                     "\"rx_mbps\": %.3f, \"rx_syscalls_per_sec\": %.0f, \"rx_cpu_ms_per_mb\": %.3f}%s\n",
+                     r.backend, r.ports, r.chunk, r.txMBps, r.txSyscallsPerSec, r.txCpuMsPerMB,
+                     r.rxMBps, r.rxSyscallsPerSec, r.rxCpuMsPerMB,
+                     i + 1 < results.size() ? "," : "");
+    }
+
+    std::fprintf(out, "  ]\n}\n");
+} /* void writeUring(FILE* out, const Options& options, const std::vector<UringResult>& results) { */
+
+void writeRawLatency(FILE* out, const Options& options, const std::vector<RawLatencyResult>& results) {
+    if (options.csv) {
+        std::fprintf(out, "mode,p50_us,p99_us,max_us,delivered,timeouts\n");
+
+        for (size_t i = 0; i < results.size(); ++i) {
+            const RawLatencyResult& r = results[i];
+            std::fprintf(out, "%s,%s,%s,%.2f,%zu,%zu\n",
+                         r.mode, formatUs(r.p50Us, true).c_str(), formatUs(r.p99Us, true).c_str(),
+                         r.maxUs, r.delivered, r.timeouts);
+        }
+        return;
+    }
+
+    std::fprintf(out, "{\n  \"benchmark\": \"raw_latency\",\n  \"transport\": \"pty\",\n  \"results\": [\n");
+
+    for (size_t i = 0; i < results.size(); ++i) {
+        const RawLatencyResult& r = results[i];
+        std::fprintf(out,
+                     "    {\"mode\": \"%s\", \"p50_us\": %s, \"p99_us\": %s, \"max_us\": %.2f, "
+                     "\"delivered\": %zu, \"timeouts\": %zu}%s\n",
+                     r.mode, formatUs(r.p50Us, false).c_str(), formatUs(r.p99Us, false).c_str(),
+                     r.maxUs, r.delivered, r.timeouts,
+                     i + 1 < results.size() ? "," : "");
+    }
+
+    std::fprintf(out, "  ]\n}\n");
+} /* void writeRawLatency(FILE* out, const Options& options, ...) { */
+
+void writeReadPolicy(FILE* out, const Options& options, const std::vector<ReadPolicyResult>& results) {
+    if (options.csv) {
+        std::fprintf(out, "policy,vmin,bytes,syscalls_per_kb,wakeups_per_kb,bytes_per_read\n");
+
+        for (size_t i = 0; i < results.size(); ++i) {
+            const ReadPolicyResult& r = results[i];
+            std::fprintf(out, "%s,%d,%llu,%.2f,%.2f,%.2f\n", r.policy, options.readPolicy,
+                         static_cast<unsigned long long>(r.bytes), r.syscallsPerKB, r.wakeupsPerKB, r.bytesPerRead);
+        }
+        return;
+    }
+
+    std::fprintf(out, "{\n  \"benchmark\": \"read_policy\",\n  \"transport\": \"pty\",\n  \"vmin\": %d,\n  \"results\": [\n",
+                 options.readPolicy);
+
+    for (size_t i = 0; i < results.size(); ++i) {
+        const ReadPolicyResult& r = results[i];
+        std::fprintf(out,
+                     "    {\"policy\": \"%s\", \"bytes\": %llu, \"syscalls_per_kb\": %.2f, "
+                     "\"wakeups_per_kb\": %.2f, \"bytes_per_read\": %.2f}%s\n",
+                     r.policy, static_cast<unsigned long long>(r.bytes), r.syscallsPerKB, r.wakeupsPerKB, r.bytesPerRead,
+                     i + 1 < results.size() ? "," : "");
+    }
+
+    std::fprintf(out, "  ]\n}\n");
+} /* void writeReadPolicy(FILE* out, const Options& options, ...) { */
+
+void writePoller(FILE* out, const Options& options, const std::vector<PollerResult>& results) {
+    if (options.csv) {
+        std::fprintf(out, "mode,p50_us,p99_us,p999_us,samples\n");
+
+        for (size_t i = 0; i < results.size(); ++i) {
+            const PollerResult& r = results[i];
+            std::fprintf(out, "%s,%s,%s,%s,%zu\n", r.mode, formatUs(r.p50Us, true).c_str(),
+                         formatUs(r.p99Us, true).c_str(), formatUs(r.p999Us, true).c_str(), r.samples);
+        }
+        return;
+    }
+
+    std::fprintf(out, "{\n  \"benchmark\": \"poller\",\n  \"transport\": \"pty\",\n  \"results\": [\n");
+
+    for (size_t i = 0; i < results.size(); ++i) {
+        const PollerResult& r = results[i];
+        std::fprintf(out,
+                     "    {\"mode\": \"%s\", \"p50_us\": %s, \"p99_us\": %s, \"p999_us\": %s, \"samples\": %zu}%s\n",
+                     r.mode, formatUs(r.p50Us, false).c_str(), formatUs(r.p99Us, false).c_str(),
+                     formatUs(r.p999Us, false).c_str(), r.samples,
+                     i + 1 < results.size() ? "," : "");
+    }
+
+    std::fprintf(out, "  ]\n}\n");
+} /* void writePoller(FILE* out, const Options& options, const std::vector<PollerResult>& results) { */
+
+} /* namespace { */
+
+int main(int argc, char** argv) {
+    Options options = parse(argc, argv);
+    FILE* out = stdout;
+
+    if (options.out != nullptr) {
+        out = std::fopen(options.out, "w");
+
+        if (out == nullptr) {
+            std::perror(options.out);
+            return 1;
+        }
+    }
+
+    if (options.registry > 0) {
+        writeRegistry(out, options, measureRegistry(options.registry, options.sweeps));
+    } else if (options.poller != nullptr) {
+        static const char* const modes[] = {"Block", "Epoll", "BusyPoll", "Hybrid"};
+        std::vector<PollerResult> results;
+
+        for (size_t m = 0; m < sizeof(modes) / sizeof(modes[0]); ++m) {
+            if (std::strcmp(options.poller, "All") == 0 || std::strcmp(options.poller, modes[m]) == 0) {
+                results.push_back(measurePoller(modes[m], options.iterations));
+            }
+        }
+
+        writePoller(out, options, results);
+    } else if (options.readPolicy > 0) {
+        std::vector<ReadPolicyResult> results;
+        results.push_back(measureReadPolicy(Uart::ReadPolicy::Any, options.readPolicy, options.durationMs));
+        results.push_back(measureReadPolicy(Uart::ReadPolicy::AtLeast, options.readPolicy, options.durationMs));
+        results.push_back(measureReadPolicy(Uart::ReadPolicy::CountOrIdle, options.readPolicy, options.durationMs));
+        writeReadPolicy(out, options, results);
+    } else if (options.rawLatency > 0) {
+        std::vector<RawLatencyResult> results;
+        results.push_back(measureRawLatency(false, options.rawLatency, 20));
+        results.push_back(measureRawLatency(true, options.rawLatency, 20));
+        writeRawLatency(out, options, results);
+    } else if (options.uring > 0) {
+        std::vector<UringResult> results;
+
+        if (!UartUring().isUringEnabled()) {
+            std::fprintf(stderr, "io_uring is unavailable, \"uring\" rows use the read()/write() fallback.\n");
+        }
+
+        for (size_t chunk = options.minChunk; chunk <= options.maxChunk; chunk *= options.chunkStep) {
+            for (int uring = 0; uring < 2; ++uring) {
+                PtyGroup group(options.uring);
+
+                UringResult result;
+                result.backend = uring ? "uring" : "readwrite";
+                result.ports   = options.uring;
+                result.chunk   = chunk;
+
+                measureUringTx(group, uring != 0, chunk, options.durationMs, result);
+                measureUringRx(group, uring != 0, chunk, options.durationMs, result);
+
+                results.push_back(result);
+            }
+
+            std::fprintf(stderr, "chunk %zu done\n", chunk);
+        } /* for (size_t chunk = options.minChunk; ...) { */
+
+        writeUring(out, options, results);
+    } else {
+        // 与Uart::configBaudRate()中的波特率表一致（B0除外）
+        static const long baudRates[] = {
+                 50,      75,     110,     134,     150,     200,     300,     600,
+               1200,    1800,    2400,    4800,    9600,   19200,   38400,   57600,
+             115200,  230400,  460800,  500000,  576000,  921600, 1000000, 1152000,
+            1500000, 2000000, 2500000, 3000000, 3500000, 4000000
+        };
+
+        std::vector<Result> results;
+
+        for (size_t b = 0; b < sizeof(baudRates) / sizeof(baudRates[0]); ++b) {
+            if (options.baud != 0 && options.baud != baudRates[b]) {
+                continue;
+            }
+
+            for (size_t chunk = options.minChunk; chunk <= options.maxChunk; chunk *= options.chunkStep) {
+                std::string path;
+                int master = openPty(path);
+                Bench bench(path.c_str(), baudRates[b], master);
+
+                Result result;
+                result.baud  = baudRates[b];
+                result.chunk = chunk;
+
+                measureTx(bench, chunk, options.durationMs, result);
+                measureRx(bench, chunk, options.durationMs, result);
+                measureRtt(bench, chunk, options.durationMs, options.iterations, result);
+
+                results.push_back(result);
+                std::fprintf(stderr, "baud %ld chunk %zu done\n", result.baud, chunk);
+            } /* for (size_t chunk = options.minChunk; ...) { */
+        } /* for (size_t b = 0; ...) { */
+
+        writeResults(out, options, results);
+    } /* if (options.registry > 0) { */
+
+    if (out != stdout) {
+        std::fclose(out);
+    }
+
+    return 0;
+} /* int main(int argc, char** argv) { */
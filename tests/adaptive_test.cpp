@@ -0,0 +1,132 @@
+/**
+ * @file adaptive_test.cpp
+ * @brief UartAdaptiveReceiver在突发结束后回到安静模式的测试
+ * @note 编译：g++ -std=c++11 -O2 -I. tests/adaptive_test.cpp -o adaptive_test -lutil -pthread
+ *       运行：./adaptive_test [REPLIES]
+ *       在伪终端上先以约1MB/s持续写入100ms使接收器进入批量模式，线路安静50ms后，
+ *       每隔30ms写入1个字节的应答。延迟上限设为20ms，每个应答从写入到receive()返回
+ *       都必须远小于延迟上限（5ms），即没有被按突发期间的速率估计批量等待。
+ *       任何检查失败时返回1
+ */
+
+// 标准库
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+// 第三方库
+#include <pty.h>
+#include <unistd.h>
+
+#include "uart_adaptive.hpp"
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+const int kBurstMs    = 100;   // 突发持续时间
+const int kQuietMs    = 50;    // 突发后的安静时间
+const int kReplyGapMs = 30;    // 应答间隔，大于延迟上限
+const double kLimitUs = 5000;  // 应答允许的最大延迟
+
+} /* namespace { */
+
+int main(int argc, char** argv) {
+    int replies = argc > 1 ? std::atoi(argv[1]) : 12;
+    int master  = -1;
+    int slave   = -1;
+    char path[64];
+
+    if (openpty(&master, &slave, path, nullptr, nullptr) == -1) {
+        std::perror("openpty");
+        return 1;
+    }
+
+    ::close(slave);
+
+    struct termios tty;
+    tcgetattr(master, &tty);
+    cfmakeraw(&tty);
+    tcsetattr(master, TCSANOW, &tty);
+
+    Uart uart(path, 115200);
+    uart.configRawMode(true);
+
+    if (!uart.open()) {
+        return 1;
+    }
+
+    UartAdaptiveReceiver::Config config = UartAdaptiveReceiver::defaultConfig();
+    config.maxLatencyUs = 20000;
+    UartAdaptiveReceiver receiver(uart, config);
+
+    std::atomic<int64_t> sentAt(0);
+    std::atomic<bool> burstDone(false);
+
+    std::thread writer([master, replies, &sentAt, &burstDone]() {
+        std::vector<char> chunk(1000, 'b');
+        Clock::time_point end = Clock::now() + std::chrono::milliseconds(kBurstMs);
+
+        // 每1ms写入1000字节，约1MB/s
+        while (Clock::now() < end) {
+            ssize_t n = ::write(master, chunk.data(), chunk.size());
+            (void)n;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        burstDone.store(true);
+        std::this_thread::sleep_for(std::chrono::milliseconds(kQuietMs));
+
+        for (int i = 0; i < replies; ++i) {
+            sentAt.store(Clock::now().time_since_epoch().count());
+            ssize_t n = ::write(master, "r", 1);
+            (void)n;
+            std::this_thread::sleep_for(std::chrono::milliseconds(kReplyGapMs));
+        }
+    });
+
+    char buffer[4096];
+    int failures = 0;
+    int received = 0;
+    uint64_t burstBulkReads = 0;
+
+    while (received < replies) {
+        size_t n = receiver.receive(buffer, sizeof(buffer), 1000);
+
+        if (n == 0) {
+            std::fprintf(stderr, "timed out waiting for data\n");
+            failures = 1;
+            break;
+        }
+
+        if (!burstDone.load() || buffer[n - 1] == 'b') {
+            burstBulkReads = receiver.getStats().bulkReads;
+            continue;
+        }
+
+        double latencyUs = std::chrono::duration<double, std::micro>(
+            Clock::now() - Clock::time_point(Clock::duration(sentAt.load()))).count();
+
+        if (latencyUs > kLimitUs) {
+            std::fprintf(stderr, "reply %d delayed %.0f us\n", received, latencyUs);
+            ++failures;
+        }
+
+        ++received;
+    } /* while (received < replies) { */
+
+    writer.join();
+
+    // 突发期间应当进入过批量模式，否则本测试没有意义
+    if (burstBulkReads == 0) {
+        std::fprintf(stderr, "receiver never entered bulk regime during the burst\n");
+        ++failures;
+    }
+
+    std::printf("adaptive_test: %d replies, %llu bulk reads during burst, %d failures\n",
+                received, static_cast<unsigned long long>(burstBulkReads), failures);
+    return failures == 0 ? 0 : 1;
+} /* int main(int argc, char** argv) { */
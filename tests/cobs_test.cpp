@@ -0,0 +1,215 @@
+/**
+ * @file cobs_test.cpp
+ * @brief COBS编解码的随机化正确性测试
+ * @note 编译：g++ -std=c++11 -O2 -I. tests/cobs_test.cpp -o cobs_test
+ *       运行：./cobs_test [ROUNDS] [SEED]
+ *       1. 随机长度（含253/254/255、508/509等块边界）与随机0x00密度的数据，
+ *          uartCobsEncode()的输出与逐字节的参考编码器逐字节比较，并经uartCobsDecode()还原（含就地解码）；
+ *       2. 把一批编码后的帧按随机大小的块交给UartBasicCobsReader，逐帧比较，
+ *          其中夹带的损坏帧必须被丢弃并计入getErrors()。
+ *       任何检查失败时输出种子与轮次并返回1
+ */
+
+// 标准库
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "uart_cobs.hpp"
+
+namespace {
+
+typedef std::mt19937 Rng;
+
+/**
+ * @brief 逐字节的COBS参考编码器，在结尾追加0x00分隔符
+ */
+std::string referenceEncode(const std::string& data) {
+    std::string out(1, '\0');
+    size_t codePos = 0;
+    unsigned code  = 1;
+
+    for (size_t i = 0; i < data.size(); ++i) {
+        if (data[i] != '\0') {
+            out.push_back(data[i]);
+            ++code;
+        }
+
+        if (data[i] == '\0' || code == 0xFF) {
+            out[codePos] = static_cast<char>(code);
+            codePos = out.size();
+            out.push_back('\0');
+            code = 1;
+        }
+    }
+
+    out[codePos] = static_cast<char>(code);
+    out.push_back('\0');
+    return out;
+}
+
+/**
+ * @brief 随机长度，一半落在块边界附近
+ */
+size_t randomLength(Rng& rng) {
+    static const size_t boundaries[] = {0, 1, 2, 253, 254, 255, 256, 507, 508, 509, 510, 762, 763};
+
+    if (rng() % 2 == 0) {
+        return boundaries[rng() % (sizeof(boundaries) / sizeof(boundaries[0]))];
+    }
+
+    return rng() % 2048;
+}
+
+/**
+ * @brief 以随机密度生成含0x00的数据，密度从全零到完全不含0x00
+ */
+std::string randomData(Rng& rng, size_t length) {
+    static const double densities[] = {0.0, 0.001, 0.01, 0.1, 0.5, 1.0};
+    double density = densities[rng() % (sizeof(densities) / sizeof(densities[0]))];
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    std::string data(length, '\0');
+
+    for (size_t i = 0; i < length; ++i) {
+        data[i] = uniform(rng) < density ? '\0' : static_cast<char>(1 + rng() % 255);
+    }
+
+    return data;
+}
+
+/**
+ * @brief 按随机大小的块交出预先准备的字节流，模拟串口的分段到达
+ */
+class ChunkTransport : public UartTransport<ChunkTransport> {
+public:
+    ChunkTransport(const std::string& stream, Rng& rng, size_t maxChunk)
+        : _stream(stream)
+        , _rng(rng)
+        , _pos(0)
+        , _maxChunk(maxChunk) {}
+
+    UartResult writeSome(const char*, size_t length) noexcept {
+        return length;
+    }
+
+    UartResult readSome(char* buffer, size_t length) noexcept {
+        if (_pos == _stream.size()) {
+            return Uart::makeError(std::make_error_code(std::errc::operation_would_block));
+        }
+
+        size_t count = 1 + _rng() % _maxChunk;
+        count = std::min(count, std::min(length, _stream.size() - _pos));
+        std::memcpy(buffer, _stream.data() + _pos, count);
+        _pos += count;
+        return count;
+    }
+
+    bool wait(short, int) noexcept {
+        return _pos < _stream.size();
+    }
+
+    int getFd() const noexcept {
+        return -1;
+    }
+
+private:
+    const std::string& _stream;
+    Rng& _rng;
+    size_t _pos;
+    size_t _maxChunk;
+};
+
+/**
+ * @brief 编码一帧并检查与参考编码器一致、可以还原
+ */
+bool checkCodec(const std::string& data) {
+    std::vector<char> encoded(uartCobsMaxEncodedSize(data.size()));
+    size_t size = uartCobsEncode(data.data(), data.size(), encoded.data());
+    std::string expected = referenceEncode(data);
+
+    if (size > encoded.size() || std::string(encoded.data(), size) != expected) {
+        std::fprintf(stderr, "encode mismatch, length %zu\n", data.size());
+        return false;
+    }
+
+    std::vector<char> decoded(size);
+    size_t decodedSize = 0;
+
+    if (!uartCobsDecode(encoded.data(), size - 1, decoded.data(), decodedSize)
+        || std::string(decoded.data(), decodedSize) != data) {
+        std::fprintf(stderr, "decode mismatch, length %zu\n", data.size());
+        return false;
+    }
+
+    // 就地解码
+    if (!uartCobsDecode(encoded.data(), size - 1, encoded.data(), decodedSize)
+        || std::string(encoded.data(), decodedSize) != data) {
+        std::fprintf(stderr, "in-place decode mismatch, length %zu\n", data.size());
+        return false;
+    }
+
+    return true;
+} /* bool checkCodec(const std::string& data) { */
+
+/**
+ * @brief 随机大小的块经UartBasicCobsReader切分、解码
+ */
+bool checkReader(Rng& rng) {
+    std::vector<std::string> frames;
+    std::string stream;
+    uint64_t corrupted = 0;
+
+    for (int i = 0; i < 64; ++i) {
+        if (rng() % 16 == 0) {
+            // 块长度越过帧尾的损坏帧
+            stream += std::string("\x05\x01\x02", 3) + '\0';
+            ++corrupted;
+            continue;
+        }
+
+        frames.push_back(randomData(rng, randomLength(rng)));
+        stream += referenceEncode(frames.back());
+    }
+
+    ChunkTransport transport(stream, rng, 1 + rng() % 600);
+    UartBasicCobsReader<ChunkTransport> reader(transport, 4096);
+    UartSpan frame;
+
+    for (size_t i = 0; i < frames.size(); ++i) {
+        if (!reader.nextUntil(frame, Uart::Clock::now())
+            || std::string(frame.data, frame.size) != frames[i]) {
+            std::fprintf(stderr, "reader mismatch at frame %zu\n", i);
+            return false;
+        }
+    }
+
+    if (reader.next(frame) || reader.getErrors() != corrupted) {
+        std::fprintf(stderr, "reader errors %llu, expected %llu\n",
+                     static_cast<unsigned long long>(reader.getErrors()),
+                     static_cast<unsigned long long>(corrupted));
+        return false;
+    }
+
+    return true;
+} /* bool checkReader(Rng& rng) { */
+
+} /* namespace { */
+
+int main(int argc, char** argv) {
+    int rounds     = argc > 1 ? std::atoi(argv[1]) : 2000;
+    unsigned seed  = argc > 2 ? static_cast<unsigned>(std::strtoul(argv[2], nullptr, 10)) : std::random_device()();
+    Rng rng(seed);
+
+    for (int round = 0; round < rounds; ++round) {
+        if (!checkCodec(randomData(rng, randomLength(rng))) || (round % 20 == 0 && !checkReader(rng))) {
+            std::fprintf(stderr, "FAILED: seed %u, round %d\n", seed, round);
+            return 1;
+        }
+    }
+
+    std::printf("cobs_test: %d rounds passed (seed %u)\n", rounds, seed);
+    return 0;
+} /* int main(int argc, char** argv) { */
@@ -0,0 +1,255 @@
+/**
+ * @file stuffing_test.cpp
+ * @brief HDLC/SLIP字节填充编解码的随机化正确性测试
+ * @note 编译：g++ -std=c++11 -O2 -I. tests/stuffing_test.cpp -o stuffing_test
+ *       运行：./stuffing_test [ROUNDS] [SEED]
+ *       每轮对HDLC与SLIP分别：
+ *       1. 以随机的特殊字节（帧标志、转义字符）密度生成数据，uartStuffEncode()的输出与逐字节的参考编码器比较；
+ *       2. 把正常帧与超长帧、中止帧（转义字符后紧跟帧标志）、非法转义帧（仅SLIP）混合成字节流，
+ *          在随机位置切分（转义字符恰好落在块尾的位置以1/2的概率切开）后送入UartStuffDecoder，
+ *          并按随机大小的块经UartStuffReader读取，解出的帧与getErrors()必须与构造时的预期一致。
+ *       任何检查失败时输出种子与轮次并返回1
+ */
+
+// 标准库
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "uart_stuffing.hpp"
+
+namespace {
+
+typedef std::mt19937 Rng;
+
+const size_t kMaxFrameSize = 512; // 解码器的最大帧长
+
+/**
+ * @brief 逐字节的参考编码器
+ */
+template <typename Codec>
+std::string referenceEncode(const std::string& data) {
+    std::string out(1, Codec::kFlag);
+
+    for (size_t i = 0; i < data.size(); ++i) {
+        if (data[i] == Codec::kFlag || data[i] == Codec::kEscape) {
+            out.push_back(Codec::kEscape);
+            out.push_back(Codec::escape(data[i]));
+        } else {
+            out.push_back(data[i]);
+        }
+    }
+
+    out.push_back(Codec::kFlag);
+    return out;
+}
+
+/**
+ * @brief 以随机密度混入帧标志与转义字符的数据
+ */
+template <typename Codec>
+std::string randomData(Rng& rng, size_t length) {
+    static const double densities[] = {0.0, 0.01, 0.1, 0.5, 1.0};
+    double density = densities[rng() % (sizeof(densities) / sizeof(densities[0]))];
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    std::string data(length, '\0');
+
+    for (size_t i = 0; i < length; ++i) {
+        if (uniform(rng) < density) {
+            data[i] = rng() % 2 == 0 ? Codec::kFlag : Codec::kEscape;
+        } else {
+            data[i] = static_cast<char>(rng() % 256);
+        }
+    }
+
+    return data;
+}
+
+/**
+ * @brief 按给定的块依次交出字节流
+ */
+class ChunkTransport : public UartTransport<ChunkTransport> {
+public:
+    ChunkTransport(const std::string& stream, Rng& rng)
+        : _stream(stream)
+        , _rng(rng)
+        , _pos(0) {}
+
+    UartResult writeSome(const char*, size_t length) noexcept {
+        return length;
+    }
+
+    UartResult readSome(char* buffer, size_t length) noexcept {
+        if (_pos == _stream.size()) {
+            return Uart::makeError(std::make_error_code(std::errc::operation_would_block));
+        }
+
+        size_t count = 1 + _rng() % 64;
+        count = std::min(count, std::min(length, _stream.size() - _pos));
+        std::memcpy(buffer, _stream.data() + _pos, count);
+        _pos += count;
+        return count;
+    }
+
+    bool wait(short, int) noexcept {
+        return _pos < _stream.size();
+    }
+
+    int getFd() const noexcept {
+        return -1;
+    }
+
+private:
+    const std::string& _stream;
+    Rng& _rng;
+    size_t _pos;
+};
+
+/**
+ * @brief 编码一帧并与参考编码器比较
+ */
+template <typename Codec>
+bool checkEncode(const std::string& data) {
+    std::vector<char> encoded(uartStuffMaxEncodedSize(data.size()));
+    size_t size = uartStuffEncode<Codec>(data.data(), data.size(), encoded.data());
+
+    if (size > encoded.size() || std::string(encoded.data(), size) != referenceEncode<Codec>(data)) {
+        std::fprintf(stderr, "encode mismatch, length %zu\n", data.size());
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief 混合正常帧与各类错误帧，返回字节流，expected与errors为预期的帧与丢弃数
+ */
+template <typename Codec>
+std::string buildStream(Rng& rng, std::vector<std::string>& expected, uint64_t& errors, bool badEscape) {
+    std::string stream;
+
+    for (int i = 0; i < 48; ++i) {
+        switch (rng() % 8) {
+            case 0: {
+                // 超长帧：解码后比最大帧长多1~64字节
+                stream += referenceEncode<Codec>(randomData<Codec>(rng, kMaxFrameSize + 1 + rng() % 64));
+                ++errors;
+                break;
+            }
+            case 1: {
+                // 中止帧：转义字符后紧跟帧标志
+                std::string encoded = referenceEncode<Codec>(randomData<Codec>(rng, rng() % 64));
+                encoded.insert(encoded.size() - 1, 1, Codec::kEscape);
+                stream += encoded;
+                ++errors;
+                break;
+            }
+            case 2: {
+                if (!badEscape) {
+                    continue;
+                }
+
+                // 非法转义：转义字符后跟普通数据
+                std::string encoded = referenceEncode<Codec>(randomData<Codec>(rng, 1 + rng() % 64));
+                encoded.insert(1 + rng() % (encoded.size() - 1), std::string(1, Codec::kEscape) + 'x');
+                stream += encoded;
+                ++errors;
+                break;
+            }
+            default: {
+                // 正常帧，长度恰为最大帧长的情况单独覆盖；空帧被忽略，不计入预期
+                std::string data = randomData<Codec>(rng, rng() % 4 == 0 ? kMaxFrameSize : rng() % 300);
+                stream += referenceEncode<Codec>(data);
+
+                if (!data.empty()) {
+                    expected.push_back(data);
+                }
+                break;
+            }
+        } /* switch (rng() % 8) { */
+    } /* for (int i = 0; i < 48; ++i) { */
+
+    return stream;
+} /* std::string buildStream(...) { */
+
+/**
+ * @brief 解出的帧与丢弃数是否与预期一致
+ */
+bool sameFrames(const char* name, const std::vector<std::string>& frames, uint64_t errors,
+                const std::vector<std::string>& expected, uint64_t expectedErrors) {
+    if (frames != expected || errors != expectedErrors) {
+        std::fprintf(stderr, "%s: %zu frames, %llu errors; expected %zu frames, %llu errors\n",
+                     name, frames.size(), static_cast<unsigned long long>(errors),
+                     expected.size(), static_cast<unsigned long long>(expectedErrors));
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief 分段送入解码器与经读取器读取，两者都必须得到预期结果
+ */
+template <typename Codec>
+bool checkDecode(Rng& rng, bool badEscape) {
+    std::vector<std::string> expected;
+    uint64_t expectedErrors = 0;
+    std::string stream = buildStream<Codec>(rng, expected, expectedErrors, badEscape);
+
+    std::vector<std::string> frames;
+    UartStuffDecoder<Codec> decoder(kMaxFrameSize);
+    size_t begin = 0;
+
+    for (size_t i = 0; i < stream.size(); ++i) {
+        bool escapeAtEnd = stream[i] == Codec::kEscape && rng() % 2 == 0;
+
+        if (escapeAtEnd || rng() % 97 == 0 || i + 1 == stream.size()) {
+            decoder.feed(stream.data() + begin, i + 1 - begin, [&frames](UartSpan frame) {
+                frames.push_back(std::string(frame.data, frame.size));
+            });
+            begin = i + 1;
+        }
+    }
+
+    if (!sameFrames("decoder", frames, decoder.getErrors(), expected, expectedErrors)) {
+        return false;
+    }
+
+    frames.clear();
+    ChunkTransport transport(stream, rng);
+    UartStuffReader<Codec, ChunkTransport> reader(transport, kMaxFrameSize, 1 + rng() % 256);
+
+    while (reader.pollUntil([&frames](UartSpan frame) {
+        frames.push_back(std::string(frame.data, frame.size));
+    }, Uart::Clock::now()) > 0) {
+    }
+
+    return sameFrames("reader", frames, reader.getErrors(), expected, expectedErrors);
+} /* bool checkDecode(Rng& rng, bool badEscape) { */
+
+} /* namespace { */
+
+int main(int argc, char** argv) {
+    int rounds    = argc > 1 ? std::atoi(argv[1]) : 500;
+    unsigned seed = argc > 2 ? static_cast<unsigned>(std::strtoul(argv[2], nullptr, 10)) : std::random_device()();
+    Rng rng(seed);
+
+    for (int round = 0; round < rounds; ++round) {
+        size_t length = rng() % 2 == 0 ? rng() % 16 : rng() % 2048;
+
+        // HDLC的任何转义序列都合法，只有SLIP测试非法转义
+        if (!checkEncode<UartHdlcCodec>(randomData<UartHdlcCodec>(rng, length))
+            || !checkEncode<UartSlipCodec>(randomData<UartSlipCodec>(rng, length))
+            || !checkDecode<UartHdlcCodec>(rng, false)
+            || !checkDecode<UartSlipCodec>(rng, true)) {
+            std::fprintf(stderr, "FAILED: seed %u, round %d\n", seed, round);
+            return 1;
+        }
+    }
+
+    std::printf("stuffing_test: %d rounds passed (seed %u)\n", rounds, seed);
+    return 0;
+} /* int main(int argc, char** argv) { */
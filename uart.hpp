@@ -2,16 +2,209 @@
 #define __UART_HPP
 
 // 标准库
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <map>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <system_error>
 
 // 第三方库
 #include <termios.h>
 #include <fcntl.h>
 #include <unistd.h>
+#include <limits.h>
+#include <sys/uio.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <linux/serial.h>
+
+// 自定义波特率（BOTHER）需要内核的struct termios2，而<asm/termbits.h>中的定义与<termios.h>冲突，
+// 因此按asm-generic的布局自行定义，TCGETS2/TCSETS2等ioctl编号已由<sys/ioctl.h>引入。
+// 其他架构（如mips、powerpc、sparc）的布局不同，不启用自定义波特率
+#if defined(TCGETS2) && (defined(__x86_64__) || defined(__i386__) || defined(__aarch64__) || \
+                         defined(__arm__) || defined(__riscv))
+#define UART_HAS_TERMIOS2 1
+
+struct termios2 {
+    tcflag_t c_iflag;
+    tcflag_t c_oflag;
+    tcflag_t c_cflag;
+    tcflag_t c_lflag;
+    cc_t c_line;
+    cc_t c_cc[19];
+    speed_t c_ispeed;
+    speed_t c_ospeed;
+};
+#endif
+
+#ifndef BOTHER
+#define BOTHER 0010000
+#endif
+
+// 未启用异常（-fno-exceptions）时，错误直接终止程序，try/catch中的处理代码不会被编译执行
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS)
+#define UART_THROW(e)          throw e
+#define UART_TRY               try
+#define UART_CATCH(type, name) catch (type& name)
+#else
+#define UART_THROW(e)          std::abort()
+#define UART_TRY               if (true)
+#define UART_CATCH(type, name) else if (type* name##_ = nullptr) for (type& name = *name##_; false; )
+#endif
+
+#if __cplusplus >= 202002L && __has_include(<span>)
+#define UART_HAS_SPAN 1
+#include <cstddef>
+#include <span>
+#endif
+
+#if __cplusplus >= 202302L && __has_include(<expected>)
+#define UART_HAS_EXPECTED 1
+#include <expected>
+
+/**
+ * @brief 非抛出接口的返回值：成功时为传输的字节数，失败时为错误码
+ */
+using UartResult = std::expected<size_t, std::error_code>;
+#else
+/**
+ * @brief 非抛出接口的返回值：成功时为传输的字节数，失败时为错误码
+ * @note C++23之前std::expected<size_t, std::error_code>的等价实现，只提供常用的成员
+ */
+class UartResult {
+public:
+    UartResult(size_t value) noexcept : _value(value), _error() {}
+    UartResult(std::error_code error) noexcept : _value(0), _error(error) {}
+
+    bool has_value() const noexcept { return !_error; }
+    explicit operator bool() const noexcept { return !_error; }
+    size_t value() const noexcept { return _value; }
+    size_t operator*() const noexcept { return _value; }
+    std::error_code error() const noexcept { return _error; }
+
+private:
+    size_t _value;
+    std::error_code _error;
+};
+#endif
+
+/**
+ * @brief 一段连续的只读内存
+ */
+struct UartSpan {
+    const char* data; // 基地址
+    size_t size;      // 长度（单位：字节）
+};
+
+/**
+ * @brief 带截止时间的接收接口的返回值，超时或出错时仍报告已完成的部分
+ */
+struct UartProgress {
+    size_t bytes;          // 已写入缓冲区的字节数
+    size_t frame;          // 仅receiveUntil()使用：含分隔符在内的帧长度，未找到分隔符时为0
+    std::error_code error; // 为空表示完成；超时为std::errc::timed_out，对端关闭为std::errc::connection_reset
+
+    bool done() const noexcept { return !error; }
+};
+
+/**
+ * @brief 串口参数，用于Uart::reconfigure()在不关闭串口的情况下整体切换配置
+ * @note 默认值与Uart构造函数的默认参数相同
+ */
+struct UartConfig {
+    speed_t baudRate = 9600; // 波特率（单位：bit/s）
+    char parity      = 'N';  // 'N'表示无校验，'E'表示偶校验，'O'表示奇校验
+    int stopBits     = 1;    // 停止位数（1或者2）
+    int dataBits     = 8;    // 数据位数（5，6，7，8）
+    bool hfc         = false; // 是否启用硬件流控制
+    bool sfc         = false; // 是否启用软件流控制
+    bool raw         = false; // 是否启用原始（二进制）模式
+};
+
+/**
+ * @brief 文件描述符的唯一所有者，只能移动不能拷贝，析构时关闭
+ */
+class UartFd {
+public:
+    explicit UartFd(int fd = -1) noexcept : _fd(fd) {}
+
+    ~UartFd() {
+        reset();
+    }
+
+    UartFd(UartFd&& other) noexcept : _fd(other.release()) {}
+
+    UartFd& operator=(UartFd&& other) noexcept {
+        if (this != &other) {
+            reset(other.release());
+        }
+        return *this;
+    }
+
+    UartFd(const UartFd&)            = delete;
+    UartFd& operator=(const UartFd&) = delete;
+
+    /**
+     * @brief 获取文件描述符，未持有时为-1
+     */
+    int get() const noexcept {
+        return _fd;
+    }
+
+    /**
+     * @brief 放弃所有权，返回文件描述符且不关闭
+     */
+    int release() noexcept {
+        int fd = _fd;
+        _fd = -1;
+        return fd;
+    }
+
+    /**
+     * @brief 关闭当前持有的文件描述符并接管新的文件描述符
+     * @return ::close()的返回值，未持有时为0
+     */
+    int reset(int fd = -1) noexcept {
+        int ret = _fd != -1 ? ::close(_fd) : 0;
+        _fd = fd;
+        return ret;
+    }
+
+private:
+    int _fd; // 持有的文件描述符
+};
 
 class Uart {
 public:
+    /**
+     * @brief 截止时间使用的单调时钟，不受系统时间调整影响
+     */
+    typedef std::chrono::steady_clock Clock;
+
+    /**
+     * @brief 读取策略，决定一次read()在内核中等待多少数据后返回
+     */
+    enum class ReadPolicy : uint8_t {
+        Any,         // 有多少读多少，无数据时立即返回（默认，非阻塞）
+        AtLeast,     // 至少读到count个字节才返回（VMIN=count，VTIME=0）
+        CountOrIdle  // 读到count个字节，或收到首字节后线路空闲idle时间即返回（VMIN=count，VTIME=idle）
+    };
+
+    /**
+     * @brief 配置生效的时机
+     */
+    enum class When : uint8_t {
+        Now,   // 立即生效（TCSANOW）
+        Drain, // 等待输出缓冲区中的数据发送完毕后生效（TCSADRAIN）
+        Flush  // 等待输出发送完毕，并丢弃尚未读取的输入后生效（TCSAFLUSH）
+    };
+
     /**
      * @brief 构造函数
      * @param port      : 串口设备路径
@@ -21,32 +214,38 @@ public:
      * @param _stopBits : 停止位数，默认为1
      * @param _dataBits : 数据位数，默认为8
      * @param _parity   : 是否启用奇偶校验，默认不启用。'N'表示无校验，'E'表示偶校验，'O'表示奇校验
-     * @note 构造函数中完成所有属性的初始化，但是不会应用设置的属性（即不会打开串口）
+     * @note 构造函数中完成所有属性的初始化，但是不会应用设置的属性（即不会打开串口）。
+     *       设备无法打开时抛出std::runtime_error，不使用异常时改用tryOpen()
      */
     Uart(const char* port, speed_t baudRate = 9600, bool hfc = false, bool sfc = false, char parity = 'N', int stopBits =1 , int dataBits = 8)
-        : _port(port)
+        : _port(checkedPort(port))
+        , _cookedIflag(0)
+        , _cookedOflag(0)
+        , _cookedLflag(0)
         , _baudRate(baudRate)
-        , _fd(-1) 
+        , _actualBaudRate(0)
+        , _readTimeoutMs(-1)
+        , _customBaudRate(false)
         , _hfc(hfc)
         , _sfc(sfc)
         , _parity(parity)
-        , _stopBits(stopBits)
-        , _dataBits(dataBits)
+        , _stopBits(narrowBits(stopBits))
+        , _dataBits(narrowBits(dataBits))
+        , _raw(false)
+        , _vmin(1)
+        , _vtime(0)
+        , _readPolicy(ReadPolicy::Any)
         , _open(false) {
-            // 安全性检查
-            if (_port == nullptr) {
-                throw std::invalid_argument("Port cannot be nullptr.");
-            }
-            
-            _fd = ::open(_port, O_RDWR | O_NOCTTY | O_NDELAY);
+            _fd.reset(::open(_port.get(), O_RDWR | O_NOCTTY | O_NDELAY));
 
-            if (_fd == -1) {
-                throw std::runtime_error("Error in opening UART port.");
-            } /* if (_fd == -1) { */
+            if (_fd.get() == -1) {
+                UART_THROW(std::runtime_error("Error in opening UART port."));
+            } /* if (_fd.get() == -1) { */
 
-            try {
+            UART_TRY {
                 _tty = getAttributes();
-            } catch (std::runtime_error& e) {
+                saveCookedFlags();
+            } UART_CATCH(std::runtime_error, e) {
                 std::cerr << e.what() << std::endl;
             }
 
@@ -57,27 +256,112 @@ public:
      * @param tty : 从外部传入的termios结构体
      */
     Uart(const char* port, const struct termios& tty)
-    : _port(port)
+    : _port(checkedPort(port))
     , _tty(tty) 
+    , _cookedIflag(0)
+    , _cookedOflag(0)
+    , _cookedLflag(0)
+    , _actualBaudRate(0)
+    , _readTimeoutMs(-1)
+    , _customBaudRate(false)
+    , _readPolicy(ReadPolicy::Any)
     , _open(false) {
-        try {
+        _fd.reset(::open(_port.get(), O_RDWR | O_NOCTTY | O_NDELAY));
+
+        if (_fd.get() == -1) {
+            UART_THROW(std::runtime_error("Error in opening UART port."));
+        }
+
+        saveCookedFlags();
+
+        UART_TRY {
             analysis(tty);
-        } catch (std::invalid_argument& e) {
+        } UART_CATCH(std::invalid_argument, e) {
             std::cerr << e.what() << std::endl;
         }
     }
 
+    /**
+     * @brief 打开串口并应用配置（非抛出版本）
+     * @param port   : 串口设备路径
+     * @param config : 串口参数
+     * @param error  : 输出，成功时为空；参数非法为std::errc::invalid_argument，其余为对应的errno错误码
+     * @return 成功时为已打开的串口；失败时为未持有文件描述符的串口，isOpen()为false
+     * @note 构造函数与open()在出错时抛出异常，-fno-exceptions下直接终止程序，
+     *       需要在出错后继续运行时使用本接口。不抛出异常、不输出日志
+     */
+    static Uart tryOpen(const char* port, const UartConfig& config, std::error_code& error) noexcept {
+        Uart uart;
+
+        error = port == nullptr || invalidConfig(config) != nullptr
+              ? std::make_error_code(std::errc::invalid_argument)
+              : std::error_code();
+
+        if (error) {
+            return uart;
+        }
+
+        uart._port.reset(copyPort(port, std::nothrow));
+
+        if (!uart._port) {
+            error = std::make_error_code(std::errc::not_enough_memory);
+            return uart;
+        }
+
+        uart._fd.reset(::open(port, O_RDWR | O_NOCTTY | O_NDELAY));
+
+        if (uart._fd.get() == -1 || tcgetattr(uart._fd.get(), &uart._tty) == -1) {
+            error = std::error_code(errno, std::generic_category());
+            uart._fd.reset();
+            return uart;
+        }
+
+        uart.saveCookedFlags();
+
+        // 参数已校验，以下配置不会失败
+        uart.configBaudRate(config.baudRate);
+        uart.configParity(config.parity);
+        uart.configStopBits(config.stopBits);
+        uart.configDataBits(config.dataBits);
+        uart.configHardwareFlowControl(config.hfc);
+        uart.configSoftwareFlowControl(config.sfc);
+
+        if (config.raw) {
+            uart.configRawMode(true);
+        }
+
+        error = uart.tryApplyAttributes(When::Now);
+
+        if (error) {
+            uart._fd.reset();
+            return uart;
+        }
+
+        uart._open = true;
+        return uart;
+    } /* static Uart tryOpen(const char* port, const UartConfig& config, std::error_code& error) noexcept { */
+
 
     ~Uart() {
 
-        try {
+        UART_TRY {
             close();
-        } catch (std::runtime_error& e) {
+        } UART_CATCH(std::runtime_error, e) {
             std::cerr << e.what() << std::endl;
         }
 
     }
 
+    /**
+     * @brief 只能移动不能拷贝，文件描述符随之转移，被移动的对象不再持有串口
+     * @note 可以直接存放在std::vector<Uart>等连续容器中，无需为每个串口单独分配内存
+     */
+    Uart(Uart&&) noexcept            = default;
+    Uart& operator=(Uart&&) noexcept = default;
+
+    Uart(const Uart&)            = delete;
+    Uart& operator=(const Uart&) = delete;
+
     /**
      * @brief 打开串口
      * @return 状态，true串口打开成功，反之表示串口打开失败
@@ -85,20 +369,18 @@ public:
     bool open() {
 
         if (!configure()) {
-            try {
+            UART_TRY {
                 close();
-            } catch (std::runtime_error& e) {
+            } UART_CATCH(std::runtime_error, e) {
                 std::cerr << e.what() << std::endl;
             }
             //close();
             return false;
         }
 
-        // 应用配置
-        try {
-            setAttributes();
-        } catch (std::runtime_error& e) {
-            std::cerr << e.what() << std::endl;
+        // 应用配置，失败时只输出日志，-fno-exceptions下也不会终止程序
+        if (tryApplyAttributes(When::Now)) {
+            std::cerr << "Error in settring attributes." << std::endl;
         }
 
         // 打开串口的步骤：
@@ -116,14 +398,13 @@ public:
      */
     void close() {
         _open = false;
-        if (_fd != -1) {
 
-            if (::close(_fd) == -1) {
-                // std::cerr << "Error closing UART port" << std::endl;
-                throw std::runtime_error("Error in closing UART port.");
-            }
+        _readFd.reset();
 
-            _fd = -1;
+        // 无论::close()是否成功，文件描述符都已释放
+        if (_fd.reset() == -1) {
+            // std::cerr << "Error closing UART port" << std::endl;
+            UART_THROW(std::runtime_error("Error in closing UART port."));
         }
     } /* void close() { */
 
@@ -136,17 +417,17 @@ public:
     ssize_t send(const char* data, size_t length) const {
 
         if (!isOpen()) {
-            throw std::runtime_error("UART port is not open.");
+            UART_THROW(std::runtime_error("UART port is not open."));
         }
 
         if (data == nullptr) {
-            throw std::invalid_argument("Data cannot be nullptr.");
+            UART_THROW(std::invalid_argument("Data cannot be nullptr."));
         }
 
-        ssize_t result = write(_fd, data, length);
+        ssize_t result = write(_fd.get(), data, length);
 
         if (result == -1) {
-            throw std::runtime_error("Error in sending data.");
+            UART_THROW(std::runtime_error("Error in sending data."));
         }
 
         return result;
@@ -157,25 +438,31 @@ public:
      * @param buffer : 数据缓冲区基地址
      * @param length : 接收的数据的最大长度（单位：字节）
      * @return 接收成功则返回接收的数据的长度，接收失败则返回-1
-     * @note 返回值可能小于length
+     * @note 返回值可能小于length。等待数据的方式由setReadPolicy()决定，
+     *       阻塞策略下超过读取超时仍无数据时返回0
      */
     ssize_t receive(char* buffer, size_t length) const {
 
         if (!isOpen()) {
-            throw std::runtime_error("UART port is not open.");
+            UART_THROW(std::runtime_error("UART port is not open."));
         }
 
         if (buffer == nullptr) {
-            throw std::invalid_argument("Buffer cannot be nullptr.");
+            UART_THROW(std::invalid_argument("Buffer cannot be nullptr."));
+        }
+
+        if (!waitReadable()) {
+            buffer[0] = '\0';
+            return 0;
         }
 
-        ssize_t result = read(_fd, buffer, length);
+        ssize_t result = read(readFd(), buffer, length);
 
         if (result == -1) {
             if (errno == EAGAIN) {
                 std::cerr << "Error: EAGAIN" << std::endl;
             }
-            throw std::runtime_error("Error in receiving data.");
+            UART_THROW(std::runtime_error("Error in receiving data."));
         } else {
             buffer[result] = '\0';
         }
@@ -183,35 +470,389 @@ public:
         return result;
     } /* ssize_t receive(char* buffer, size_t length) { */
 
+    /**
+     * @brief 串口集中发送多段数据
+     * @param iov   : 数据段数组，例如帧头、负载、校验码分别位于不同缓冲区
+     * @param count : 数据段个数（不超过IOV_MAX）
+     * @return 实际发送的数据总长度，可能小于各段长度之和，此时可用advanceIovec()跳过已发送部分后重试
+     * @note 各段数据通过一次writev()系统调用发送，无需先拷贝到同一缓冲区
+     */
+    ssize_t sendv(const struct iovec* iov, int count) const {
+
+        if (!isOpen()) {
+            UART_THROW(std::runtime_error("UART port is not open."));
+        }
+
+        if (iov == nullptr || count <= 0 || count > IOV_MAX) {
+            UART_THROW(std::invalid_argument("Invalid iovec array."));
+        }
+
+        ssize_t result = writev(_fd.get(), iov, count);
+
+        if (result == -1) {
+            UART_THROW(std::runtime_error("Error in sending data."));
+        }
+
+        return result;
+    } /* ssize_t sendv(const struct iovec* iov, int count) const { */
+
+    /**
+     * @brief 串口分散接收数据到多个缓冲区
+     * @param iov   : 缓冲区数组，按顺序依次填满
+     * @param count : 缓冲区个数（不超过IOV_MAX）
+     * @return 实际接收的数据总长度，可能小于各缓冲区长度之和
+     * @note 通过一次readv()系统调用完成，与receive()不同，不会在数据末尾写入'\0'
+     */
+    ssize_t receivev(const struct iovec* iov, int count) const {
+
+        if (!isOpen()) {
+            UART_THROW(std::runtime_error("UART port is not open."));
+        }
+
+        if (iov == nullptr || count <= 0 || count > IOV_MAX) {
+            UART_THROW(std::invalid_argument("Invalid iovec array."));
+        }
+
+        if (!waitReadable()) {
+            return 0;
+        }
+
+        ssize_t result = readv(readFd(), iov, count);
+
+        if (result == -1) {
+            UART_THROW(std::runtime_error("Error in receiving data."));
+        }
+
+        return result;
+    } /* ssize_t receivev(const struct iovec* iov, int count) const { */
+
+    /**
+     * @brief 跳过iovec数组中已经完成传输的部分
+     * @param iov   : 数据段数组，执行后指向第一个未完成的数据段
+     * @param count : 数据段个数，执行后为剩余的数据段个数
+     * @param bytes : sendv()/receivev()返回的已传输长度
+     * @note 会修改未完成的第一个数据段的iov_base与iov_len，用于部分传输后继续调用sendv()/receivev()
+     */
+    static void advanceIovec(struct iovec*& iov, int& count, size_t bytes) {
+        while (count > 0 && bytes >= iov->iov_len) {
+            bytes -= iov->iov_len;
+            ++iov;
+            --count;
+        }
+
+        if (count > 0) {
+            iov->iov_base = static_cast<char*>(iov->iov_base) + bytes;
+            iov->iov_len -= bytes;
+        }
+    } /* static void advanceIovec(struct iovec*& iov, int& count, size_t bytes) { */
+
+    /**
+     * @brief 串口发送数据（非抛出版本）
+     * @param data   : 需要发送的数据的基地址
+     * @param length : 发送的数据的长度（单位：字节）
+     * @return 成功时为发送的数据长度；发送缓冲区已满时为std::errc::operation_would_block，
+     *         其余失败为对应的errno错误码
+     * @note 不抛出异常、不输出日志、不分配内存，可在-fno-exceptions下使用
+     */
+    UartResult trySend(const char* data, size_t length) const noexcept {
+
+        if (!isOpen()) {
+            return makeError(std::make_error_code(std::errc::bad_file_descriptor));
+        }
+
+        if (data == nullptr) {
+            return makeError(std::make_error_code(std::errc::invalid_argument));
+        }
+
+        ssize_t result;
+
+        do {
+            result = write(_fd.get(), data, length);
+        } while (result == -1 && errno == EINTR);
+
+        if (result == -1) {
+            return errnoResult(errno);
+        }
+
+        return static_cast<size_t>(result);
+    } /* UartResult trySend(const char* data, size_t length) const noexcept { */
+
+    /**
+     * @brief 串口接收数据（非抛出版本）
+     * @param buffer : 数据缓冲区基地址
+     * @param length : 接收的数据的最大长度（单位：字节）
+     * @return 成功时为接收的数据长度；暂无数据（或阻塞策略下读取超时）时为std::errc::operation_would_block，
+     *         其余失败为对应的errno错误码
+     * @note 不抛出异常、不输出日志、不分配内存，可在-fno-exceptions下使用。
+     *       与receive()不同，不会在数据末尾写入'\0'，缓冲区无需预留额外的字节
+     */
+    UartResult tryReceive(char* buffer, size_t length) const noexcept {
+
+        if (!isOpen()) {
+            return makeError(std::make_error_code(std::errc::bad_file_descriptor));
+        }
+
+        if (buffer == nullptr) {
+            return makeError(std::make_error_code(std::errc::invalid_argument));
+        }
+
+        if (!waitReadable()) {
+            return makeError(std::make_error_code(std::errc::operation_would_block));
+        }
+
+        ssize_t result;
+
+        do {
+            result = read(readFd(), buffer, length);
+        } while (result == -1 && errno == EINTR);
+
+        if (result == -1) {
+            return errnoResult(errno);
+        }
+
+        if (result == 0 && length > 0 && emptyReadReturnsZero()) {
+            return makeError(std::make_error_code(std::errc::operation_would_block));
+        }
+
+        return static_cast<size_t>(result);
+    } /* UartResult tryReceive(char* buffer, size_t length) const noexcept { */
+
+    /**
+     * @brief 串口集中发送多段数据（非抛出版本）
+     * @note 返回值与trySend()相同，部分发送语义与sendv()相同
+     */
+    UartResult trySendv(const struct iovec* iov, int count) const noexcept {
+
+        if (!isOpen()) {
+            return makeError(std::make_error_code(std::errc::bad_file_descriptor));
+        }
+
+        if (iov == nullptr || count <= 0 || count > IOV_MAX) {
+            return makeError(std::make_error_code(std::errc::invalid_argument));
+        }
+
+        ssize_t result;
+
+        do {
+            result = writev(_fd.get(), iov, count);
+        } while (result == -1 && errno == EINTR);
+
+        if (result == -1) {
+            return errnoResult(errno);
+        }
+
+        return static_cast<size_t>(result);
+    } /* UartResult trySendv(const struct iovec* iov, int count) const noexcept { */
+
+    /**
+     * @brief 串口分散接收数据到多个缓冲区（非抛出版本）
+     * @note 返回值与tryReceive()相同，部分接收语义与receivev()相同
+     */
+    UartResult tryReceivev(const struct iovec* iov, int count) const noexcept {
+
+        if (!isOpen()) {
+            return makeError(std::make_error_code(std::errc::bad_file_descriptor));
+        }
+
+        if (iov == nullptr || count <= 0 || count > IOV_MAX) {
+            return makeError(std::make_error_code(std::errc::invalid_argument));
+        }
+
+        if (!waitReadable()) {
+            return makeError(std::make_error_code(std::errc::operation_would_block));
+        }
+
+        ssize_t result;
+
+        do {
+            result = readv(readFd(), iov, count);
+        } while (result == -1 && errno == EINTR);
+
+        if (result == -1) {
+            return errnoResult(errno);
+        }
+
+        return static_cast<size_t>(result);
+    } /* UartResult tryReceivev(const struct iovec* iov, int count) const noexcept { */
+
+#ifdef UART_HAS_SPAN
+    /**
+     * @brief 串口接收数据到调用者提供的内存
+     * @param buffer : 接收缓冲区，可以是调用者或环形缓冲区持有的内存
+     * @return 接收的数据长度，暂无数据（或阻塞策略下读取超时）时返回0
+     * @note 与receive(char*, size_t)不同，不会在数据末尾写入'\0'，缓冲区可以被完全填满
+     */
+    size_t receive(std::span<std::byte> buffer) const {
+        UartResult result = tryReceive(buffer);
+
+        if (!result.has_value()) {
+            if (result.error() == std::errc::operation_would_block) {
+                return 0;
+            }
+
+            if (result.error() == std::errc::bad_file_descriptor) {
+                UART_THROW(std::runtime_error("UART port is not open."));
+            }
+
+            UART_THROW(std::runtime_error("Error in receiving data."));
+        }
+
+        return *result;
+    } /* size_t receive(std::span<std::byte> buffer) const { */
+
+    /**
+     * @brief 串口发送数据
+     * @param data : 需要发送的数据
+     * @return 发送的数据长度，暂时不可写时返回0
+     */
+    size_t send(std::span<const std::byte> data) const {
+        UartResult result = trySend(data);
+
+        if (!result.has_value()) {
+            if (result.error() == std::errc::operation_would_block) {
+                return 0;
+            }
+
+            if (result.error() == std::errc::bad_file_descriptor) {
+                UART_THROW(std::runtime_error("UART port is not open."));
+            }
+
+            UART_THROW(std::runtime_error("Error in sending data."));
+        }
+
+        return *result;
+    } /* size_t send(std::span<const std::byte> data) const { */
+
+    /**
+     * @brief 串口接收数据（非抛出版本），不写入'\0'
+     */
+    UartResult tryReceive(std::span<std::byte> buffer) const noexcept {
+        // 空缓冲区的data()可能为nullptr，仍按0字节读取处理
+        static char empty;
+        char* data = buffer.empty() ? &empty : reinterpret_cast<char*>(buffer.data());
+        return tryReceive(data, buffer.size());
+    }
+
+    /**
+     * @brief 串口发送数据（非抛出版本）
+     */
+    UartResult trySend(std::span<const std::byte> data) const noexcept {
+        static const char empty = 0;
+        const char* bytes = data.empty() ? &empty : reinterpret_cast<const char*>(data.data());
+        return trySend(bytes, data.size());
+    }
+#endif /* UART_HAS_SPAN */
+
+    /**
+     * @brief 在指定时间内等待并接收数据
+     * @param buffer  : 数据缓冲区基地址
+     * @param length  : 接收的数据的最大长度（单位：字节）
+     * @param timeout : 最长等待时间
+     * @return 读到数据即返回，bytes为接收的数据长度；超时则error为std::errc::timed_out
+     * @note 以下带截止时间的接口用ppoll()在内核中等待，不忙等也不休眠，到期即返回。
+     *       始终从非阻塞的getFd()读取，与读取策略无关。
+     *       不抛出异常，不会在数据末尾写入'\0'
+     */
+    UartProgress receiveFor(char* buffer, size_t length, Clock::duration timeout) const noexcept {
+        UartProgress progress = {0, 0, std::error_code()};
+
+        progress.error = checkReceive(buffer);
+
+        if (!progress.error && length > 0) {
+            progress.error = readBefore(buffer, length, deadlineAfter(timeout), progress.bytes);
+        }
+
+        return progress;
+    } /* UartProgress receiveFor(char* buffer, size_t length, Clock::duration timeout) const noexcept { */
+
+    /**
+     * @brief 在截止时间前接收恰好length个字节
+     * @param buffer   : 数据缓冲区基地址
+     * @param length   : 接收的数据长度（单位：字节）
+     * @param deadline : 截止时间，Clock::time_point::max()表示一直等待
+     * @return 收满length个字节时完成；否则bytes为已接收的部分，error说明原因
+     */
+    UartProgress receiveExact(char* buffer, size_t length, Clock::time_point deadline) const noexcept {
+        UartProgress progress = {0, 0, std::error_code()};
+
+        progress.error = checkReceive(buffer);
+
+        while (!progress.error && progress.bytes < length) {
+            size_t got = 0;
+            progress.error  = readBefore(buffer + progress.bytes, length - progress.bytes, deadline, got);
+            progress.bytes += got;
+        }
+
+        return progress;
+    } /* UartProgress receiveExact(char* buffer, size_t length, Clock::time_point deadline) const noexcept { */
+
+    /**
+     * @brief 在截止时间前接收数据，直到收到分隔符
+     * @param buffer    : 数据缓冲区基地址
+     * @param length    : 缓冲区长度（单位：字节）
+     * @param delimiter : 分隔符，例如'\n'
+     * @param deadline  : 截止时间，Clock::time_point::max()表示一直等待
+     * @return 收到分隔符时完成，frame为含分隔符在内的帧长度；
+     *         缓冲区已满仍未收到分隔符时error为std::errc::no_buffer_space
+     * @note 串口不支持回退数据，一次read()可能读到分隔符之后的数据，它们同样留在缓冲区中，
+     *       即buffer[frame, bytes)，由调用者处理。每次只扫描新读到的数据
+     */
+    UartProgress receiveUntil(char* buffer, size_t length, char delimiter, Clock::time_point deadline) const noexcept {
+        UartProgress progress = {0, 0, std::error_code()};
+
+        progress.error = checkReceive(buffer);
+
+        while (!progress.error) {
+            if (progress.bytes == length) {
+                progress.error = std::make_error_code(std::errc::no_buffer_space);
+                break;
+            }
+
+            size_t got = 0;
+            progress.error = readBefore(buffer + progress.bytes, length - progress.bytes, deadline, got);
+
+            const void* found = got > 0 ? std::memchr(buffer + progress.bytes, delimiter, got) : nullptr;
+            progress.bytes += got;
+
+            if (found != nullptr) {
+                progress.frame = static_cast<const char*>(found) - buffer + 1;
+                progress.error = std::error_code();
+                break;
+            }
+        } /* while (!progress.error) { */
+
+        return progress;
+    } /* UartProgress receiveUntil(char* buffer, size_t length, char delimiter, ...) const noexcept { */
+
 
     /**
      * @brief 配置波特率
      * @param baudRate : 波特率，直接传入实际大小，而非termios定义的位图
-     * @note 一旦修改配置，串口将自动关闭，需要重新打开串口
+     * @note 一旦修改配置，串口将自动关闭，需要重新打开串口。
+     *       不在Bxxx标准表中的波特率（如250000、1843200、12000000）通过termios2的BOTHER设置，
+     *       驱动实际采用的波特率由getActualBaudRate()读回，偏差由getBaudRateError()给出
      */
     void configBaudRate(speed_t baudRate) {
-        _baudRate = baudRate;
-        _open     = false;
-
-        // 输入值和位图之间的映射
-        static const std::map<speed_t, speed_t> baudRateMap = {
-            {      0,       B0}, {     50,      B50}, {     75,      B75},
-            {    110,     B110}, {    134,     B134}, {    150,     B150},
-            {    200,     B200}, {    300,     B300}, {    600,     B600},
-            {   1200,    B1200}, {   1800,    B1800}, {   2400,    B2400},
-            {   4800,    B4800}, {   9600,    B9600}, {  19200,   B19200},
-            {  38400,   B38400}, {  57600,   B57600}, { 115200,  B115200},
-            { 230400,  B230400}, { 460800,  B460800}, { 500000,  B500000},
-            { 576000,  B576000}, { 921600,  B921600}, {1000000, B1000000},
-            {1152000, B1152000}, {1500000, B1500000}, {2000000, B2000000},
-            {2500000, B2500000}, {3000000, B3000000}, {3500000, B3500000},
-            {4000000, B4000000}
-        };
+        _baudRate       = baudRate;
+        _customBaudRate = false;
+        _actualBaudRate = 0;
+        _open           = false;
 
+        const std::map<speed_t, speed_t>& baudRateMap = baudRateTable();
         auto item = baudRateMap.find(_baudRate);
         
         if (item == baudRateMap.end()) {
-            throw std::invalid_argument("Invalid baud rate config");
+#ifdef UART_HAS_TERMIOS2
+            if (baudRate == 0) {
+                UART_THROW(std::invalid_argument("Invalid baud rate config"));
+            }
+
+            // 速率在应用配置时由TCSETS2写入
+            _customBaudRate = true;
+            return;
+#else
+            UART_THROW(std::invalid_argument("Invalid baud rate config"));
+#endif
         }
 
         // 这两个API本质上仍然是在操作_tty结构体，并未应用更改
@@ -225,7 +866,12 @@ public:
      * @note 一旦修改配置，串口将自动关闭，需要重新打开串口
      */
     void configDataBits(int dataBits) {
-        _dataBits     = dataBits;
+        if (dataBits < 5 || dataBits > 8) {
+            UART_THROW(std::invalid_argument("Invalid data bits config."));
+        }
+
+        // 校验之后再收窄为uint8_t
+        _dataBits     = static_cast<uint8_t>(dataBits);
         _open         = false;
         _tty.c_cflag &= ~CSIZE; // 清除旧的数据位设置
 
@@ -239,11 +885,9 @@ public:
             case 7:
                 _tty.c_cflag |= CS7;
                 break;
-            case 8:
+            default:
                 _tty.c_cflag |= CS8;
                 break;
-            default:
-                throw std::invalid_argument("Invalid data bits config.");
         }
         // tcsetattr(_fd, TCSANOW, &_tty);
         // setAttributes(_tty);
@@ -268,10 +912,10 @@ public:
                 break;
             case 'O': // 奇校验
                 _tty.c_cflag |= PARENB;
-                _tty.c_cflag &= PARODD;
+                _tty.c_cflag |= PARODD;
                 break;
             default:
-                throw std::invalid_argument("Invalid parity config.");
+                UART_THROW(std::invalid_argument("Invalid parity config."));
                 break;
         } /* switch (parity) { */
         // tcsetattr(_fd, TCSANOW, &_tty);
@@ -284,15 +928,17 @@ public:
      * @note 一旦修改配置，串口将自动关闭，需要重新打开串口
      */
     void configStopBits(int stopBits) {
-        _stopBits = stopBits;
+        if (stopBits != 1 && stopBits != 2) {
+            UART_THROW(std::invalid_argument("Invalid stop bits config."));
+        }
+
+        _stopBits = static_cast<uint8_t>(stopBits);
         _open     = false;
 
         if (stopBits == 1) {
             _tty.c_cflag &= ~CSTOPB;
-        } else if (stopBits == 2) {
-            _tty.c_cflag |= CSTOPB;
         } else {
-            throw std::invalid_argument("Invalid stop bits config.");
+            _tty.c_cflag |= CSTOPB;
         }
 
         // tcsetattr(_fd, TCSANOW, &_tty);
@@ -336,6 +982,200 @@ public:
         // setAttributes(_tty);
     } /* void configSoftwareFlowControl(bool state) { */
 
+    /**
+     * @brief 配置原始（二进制）模式
+     * @param enable : 是否启用原始模式
+     * @param vmin   : 原始模式下read()至少等待的字节数（VMIN），默认为1
+     * @param vtime  : 原始模式下read()的字节间超时（VTIME，单位：0.1秒），默认为0
+     * @note 启用后关闭行缓冲（ICANON）、回显（ECHO）、信号字符（ISIG）、输出处理（OPOST）
+     *       以及输入的CR/LF转换等，效果等同于cfmakeraw()，但保留数据位、校验位与流控制的配置，
+     *       使字节无需等待换行即可被receive()读取，且不会被改写。
+     *       关闭时恢复启用原始模式之前（即打开设备时）的输入、输出与本地标志，不会额外开启回显等功能。
+     *       VMIN/VTIME只对阻塞读取有效，以O_NDELAY打开的串口上read()总是立即返回；
+     *       vmin为0时无数据的read()返回0，非抛出接口将其报告为operation_would_block而非对端关闭。
+     *       一旦修改配置，串口将自动关闭，需要重新打开串口
+     */
+    void configRawMode(bool enable, cc_t vmin = 1, cc_t vtime = 0) {
+        if (enable && !_raw) {
+            saveCookedFlags();
+        }
+
+        _raw   = enable;
+        _vmin  = vmin;
+        _vtime = vtime;
+        _open  = false;
+
+        if (enable) {
+            _tty.c_iflag &= ~(IGNBRK | BRKINT | PARMRK | ISTRIP | INLCR | IGNCR | ICRNL);
+            _tty.c_oflag &= ~OPOST;
+            _tty.c_lflag &= ~(ECHO | ECHONL | ICANON | ISIG | IEXTEN);
+            _tty.c_cflag |= (CLOCAL | CREAD); // 忽略调制解调器控制线，使能接收
+            _tty.c_cc[VMIN]  = vmin;
+            _tty.c_cc[VTIME] = vtime;
+        } else {
+            _tty.c_iflag = _cookedIflag;
+            _tty.c_oflag = _cookedOflag;
+            _tty.c_lflag = _cookedLflag;
+            // 流控制不属于原始模式，保持当前配置
+            _tty.c_iflag = _sfc ? (_tty.c_iflag | IXON | IXOFF | IXANY) : (_tty.c_iflag & ~(IXON | IXOFF | IXANY));
+        } /* if (enable) { */
+    } /* void configRawMode(bool enable, cc_t vmin = 1, cc_t vtime = 0) { */
+
+    /**
+     * @brief 设置读取策略
+     * @param policy    : 读取策略
+     * @param count     : AtLeast/CountOrIdle策略下一次读取期望的字节数（VMIN），默认为1
+     * @param idle      : CountOrIdle策略下的线路空闲时间（VTIME，单位：0.1秒），默认为1
+     * @param timeoutMs : 阻塞策略下等待首个字节的最长时间（毫秒），-1表示一直等待，默认为-1
+     * @note 由内核按VMIN/VTIME攒够数据后再唤醒读取线程，减少小块读取带来的系统调用与唤醒次数。
+     *       Any策略使用非阻塞读取；VMIN/VTIME只对阻塞读取有效，其余策略下receive()/tryReceive()等
+     *       改从重新打开设备得到的阻塞文件描述符读取，并在read()前用poll()等待首个字节以实现读取超时。
+     *       getFd()返回的文件描述符始终保持非阻塞，trySend()的operation_would_block语义、
+     *       带截止时间的接收接口以及UartTxQueue等基于getFd()的组件都不受读取策略影响。
+     *       VMIN/VTIME只在非规范模式下生效，应与configRawMode(true)一起使用。
+     *       可以在串口打开期间随时切换，立即生效且不会关闭串口。
+     *       设备以TIOCEXCL独占打开、已被删除或改名时无法重新打开，此时退回到在getFd()上用poll()等待
+     *       首个字节（timeoutMs为-1时一直等待）后非阻塞读取：AtLeast仍由VMIN决定poll()何时返回，
+     *       CountOrIdle的VTIME不再生效，读到首个字节后立即返回。参数非法或应用配置失败时抛出异常，
+     *       读取策略保持不变
+     */
+    void setReadPolicy(ReadPolicy policy, cc_t count = 1, cc_t idle = 1, int timeoutMs = -1) {
+        if (count == 0) {
+            UART_THROW(std::invalid_argument("Read count cannot be zero."));
+        }
+
+        cc_t vmin;
+        cc_t vtime;
+
+        switch (policy) {
+            case ReadPolicy::Any:
+                // VMIN=0时非阻塞read()在无数据时返回0而非EAGAIN，保持为1
+                vmin  = 1;
+                vtime = 0;
+                break;
+            case ReadPolicy::AtLeast:
+                vmin  = count;
+                vtime = 0;
+                break;
+            case ReadPolicy::CountOrIdle:
+                vmin  = count;
+                vtime = idle;
+                break;
+            default:
+                UART_THROW(std::invalid_argument("Invalid read policy."));
+        }
+
+        // 先打开阻塞文件描述符再修改任何状态；O_NONBLOCK属于打开的文件描述（dup()得到的副本共享），
+        // 因此需要重新打开设备得到独立的阻塞文件描述，打开失败时退回到poll()等待
+        UartFd readFd;
+
+        if (_fd.get() != -1 && policy != ReadPolicy::Any && _readFd.get() == -1) {
+            readFd.reset(::open(_port.get(), O_RDONLY | O_NOCTTY));
+        }
+
+        struct termios before = _tty;
+        _tty.c_cc[VMIN]  = vmin;
+        _tty.c_cc[VTIME] = vtime;
+
+        // 直接应用，不经过setAttributes()，串口保持打开；失败时恢复原配置
+        if (_fd.get() != -1 && tryApplyAttributes(When::Now)) {
+            _tty = before;
+            UART_THROW(std::runtime_error("Error in settring attributes."));
+        }
+
+        _vmin          = vmin;
+        _vtime         = vtime;
+        _readPolicy    = policy;
+        _readTimeoutMs = timeoutMs;
+
+        if (policy == ReadPolicy::Any) {
+            _readFd.reset();
+        } else if (readFd.get() != -1) {
+            _readFd = std::move(readFd);
+        }
+    } /* void setReadPolicy(ReadPolicy policy, ...) { */
+
+    /**
+     * @brief 在不关闭串口的情况下切换配置
+     * @param config : 新的串口参数
+     * @param when   : 配置生效的时机，默认立即生效
+     * @note 只修改与当前配置不同的参数，并用一次tcsetattr()（自定义波特率为一次TCSETS2）应用，
+     *       配置没有变化时不产生系统调用。串口保持打开，Now与Drain不会丢弃已接收的数据，
+     *       适用于固件握手过程中切换波特率等场景。参数非法时抛出异常，当前配置保持不变
+     */
+    void reconfigure(const UartConfig& config, When when = When::Now) {
+        // 先整体校验，避免只应用了一部分参数
+        const char* invalid = invalidConfig(config);
+
+        if (invalid != nullptr) {
+            UART_THROW(std::invalid_argument(invalid));
+        }
+
+        bool open = _open;
+        speed_t baudRate = _baudRate;
+        struct termios before = _tty;
+
+        if (config.baudRate != _baudRate) {
+            configBaudRate(config.baudRate);
+        }
+
+        if (config.dataBits != _dataBits) {
+            configDataBits(config.dataBits);
+        }
+
+        if (config.parity != _parity) {
+            configParity(config.parity);
+        }
+
+        if (config.stopBits != _stopBits) {
+            configStopBits(config.stopBits);
+        }
+
+        if (config.hfc != _hfc) {
+            configHardwareFlowControl(config.hfc);
+        }
+
+        if (config.sfc != _sfc) {
+            configSoftwareFlowControl(config.sfc);
+        }
+
+        if (config.raw != _raw) {
+            configRawMode(config.raw, _vmin, _vtime);
+        }
+
+        // config*()会将串口标记为关闭，这里恢复原状态
+        _open = open;
+
+        if (_fd.get() == -1 || (baudRate == _baudRate && sameAttributes(before, _tty))) {
+            return;
+        }
+
+        applyAttributes(when);
+    } /* void reconfigure(const UartConfig& config, When when = When::Now) { */
+
+    /**
+     * @brief 设置驱动的低延迟模式（ASYNC_LOW_LATENCY）
+     * @param enable : 是否启用低延迟模式
+     * @return true表示设置成功，false表示驱动不支持（例如伪终端、部分USB转串口）
+     * @note 启用后驱动收到数据立即推送给tty层，而不是等待定时器批量推送，
+     *       以更高的CPU占用换取更低的接收延迟。通过TIOCSSERIAL立即生效，串口保持打开
+     */
+    bool setLowLatency(bool enable) {
+        struct serial_struct serial;
+
+        if (ioctl(_fd.get(), TIOCGSERIAL, &serial) == -1) {
+            return false;
+        }
+
+        if (enable) {
+            serial.flags |= ASYNC_LOW_LATENCY;
+        } else {
+            serial.flags &= ~ASYNC_LOW_LATENCY;
+        }
+
+        return ioctl(_fd.get(), TIOCSSERIAL, &serial) != -1;
+    } /* bool setLowLatency(bool enable) { */
+
     /**
      * @brief 应用配置
      * @note 串口的所有配置应该写入_tty结构体中，然后再调佣此API进行应用
@@ -344,32 +1184,52 @@ public:
     void setAttributes() {
         _open = false;
 
-        if (tcsetattr(_fd, TCSANOW, &_tty) ==  -1) {
-            throw std::runtime_error("Error in settring attributes.");
-        }
-
+        applyAttributes();
     }
 
     /**
      * @brief 获取串口设备路径
      */
     const char* getPort() const {
-        return _port;
+        return _port ? _port.get() : "";
     }
 
     /**
      * @brief 获取波特率
+     * @return 配置的波特率（单位：bit/s）
      */
     int getBaudRate() const {
         return _baudRate;
     }
 
+    /**
+     * @brief 获取驱动实际采用的波特率
+     * @return 应用配置后从驱动读回的波特率（单位：bit/s），尚未应用配置时为0
+     * @note 驱动受时钟分频限制，可能只能采用与配置值相近的波特率
+     */
+    speed_t getActualBaudRate() const {
+        return _actualBaudRate;
+    }
+
+    /**
+     * @brief 获取实际波特率相对配置值的偏差
+     * @return 偏差百分比，正值表示实际波特率偏高；尚未应用配置时为0
+     * @note 收发两端的累计偏差超过约2%~3%时，帧末尾的数据位可能采样错误
+     */
+    double getBaudRateError() const {
+        if (_actualBaudRate == 0 || _baudRate == 0) {
+            return 0;
+        }
+
+        return (static_cast<double>(_actualBaudRate) - _baudRate) * 100.0 / _baudRate;
+    }
+
     /**
      * @brief 获取当前设备的文件描述符
      * @return 返回文件描述符
      */
     int getFd() const {
-        return _fd;
+        return _fd.get();
     } /* int getFd() const { */
 
     /**
@@ -396,12 +1256,58 @@ public:
         return _stopBits;
     }
 
+    /**
+     * @brief 获取数据位数
+     * @return 返回数据位数
+     */
+    int getDataBits() const {
+        return _dataBits;
+    }
+
+    /**
+     * @brief 获取奇偶校验类型
+     * @return 'N'表示无校验，'E'表示偶校验，'O'表示奇校验
+     */
+    char getParity() const {
+        return _parity;
+    }
+
+    /**
+     * @brief 获取原始模式状态
+     * @return true表示启用原始模式，反之表示规范模式
+     */
+    bool getRawMode() const {
+        return _raw;
+    }
+
+    /**
+     * @brief 获取当前的串口参数
+     */
+    UartConfig getConfig() const {
+        UartConfig config;
+        config.baudRate = _baudRate;
+        config.parity   = _parity;
+        config.stopBits = _stopBits;
+        config.dataBits = _dataBits;
+        config.hfc      = _hfc;
+        config.sfc      = _sfc;
+        config.raw      = _raw;
+        return config;
+    }
+
+    /**
+     * @brief 获取读取策略
+     */
+    ReadPolicy getReadPolicy() const {
+        return _readPolicy;
+    }
+
     /**
      * @brief 检查串口是否已经打开
      * @return true表示串口已经打开，反之表示串口未打开
      */
     bool isOpen() const {
-        return _open;
+        return _open && _fd.get() != -1;
     } /* bool isOpen() const { */
     
     /**
@@ -411,30 +1317,380 @@ public:
     struct termios getAttributes() const {
         struct termios tty;
 
-        if (tcgetattr(_fd, &tty) ==  -1) {
-            throw std::runtime_error("Error in getting attributes.");
-        } /* if (tcgetattr(_fd, &tty) == -1) { */
+        if (tcgetattr(_fd.get(), &tty) ==  -1) {
+            UART_THROW(std::runtime_error("Error in getting attributes."));
+        } /* if (tcgetattr(_fd.get(), &tty) == -1) { */
 
         return tty;
     } /* struct termios getAttributs() const { */
 
+    /**
+     * @brief 构造非抛出接口的失败结果
+     * @note 与errnoResult()一样供其他组件（PortRegistry、UartTransport等）复用
+     */
+    static UartResult makeError(std::error_code error) noexcept {
+#ifdef UART_HAS_EXPECTED
+        return std::unexpected(error);
+#else
+        return UartResult(error);
+#endif
+    }
+
+    /**
+     * @brief 将errno转换为非抛出接口的失败结果，EAGAIN与EWOULDBLOCK统一为operation_would_block
+     */
+    static UartResult errnoResult(int error) noexcept {
+        if (error == EAGAIN || error == EWOULDBLOCK) {
+            return makeError(std::make_error_code(std::errc::operation_would_block));
+        }
+
+        return makeError(std::error_code(error, std::generic_category()));
+    }
+
 private:
+    /**
+     * @brief 检查并复制设备路径
+     */
+    static char* checkedPort(const char* port) {
+        if (port == nullptr) {
+            UART_THROW(std::invalid_argument("Port cannot be nullptr."));
+        }
+
+        size_t length = std::strlen(port) + 1;
+        return static_cast<char*>(std::memcpy(new char[length], port, length));
+    }
+
+    /**
+     * @brief 复制设备路径，内存不足时返回nullptr
+     */
+    static char* copyPort(const char* port, const std::nothrow_t& tag) noexcept {
+        size_t length = std::strlen(port) + 1;
+        char* copy = new (tag) char[length];
+        return copy != nullptr ? static_cast<char*>(std::memcpy(copy, port, length)) : nullptr;
+    }
+
+    /**
+     * @brief 把数据位数/停止位数收窄为uint8_t，超出范围的值记为0，由open()中的校验拒绝
+     */
+    static uint8_t narrowBits(int bits) noexcept {
+        return bits > 0 && bits <= 8 ? static_cast<uint8_t>(bits) : 0;
+    }
+
+    /**
+     * @brief 不打开设备的构造函数，供tryOpen()使用
+     */
+    Uart() noexcept
+        : _tty()
+        , _cookedIflag(0)
+        , _cookedOflag(0)
+        , _cookedLflag(0)
+        , _baudRate(9600)
+        , _actualBaudRate(0)
+        , _readTimeoutMs(-1)
+        , _customBaudRate(false)
+        , _hfc(false)
+        , _sfc(false)
+        , _parity('N')
+        , _stopBits(1)
+        , _dataBits(8)
+        , _raw(false)
+        , _vmin(1)
+        , _vtime(0)
+        , _readPolicy(ReadPolicy::Any)
+        , _open(false) {}
+
+    /**
+     * @brief 整体校验串口参数
+     * @return 参数合法时为nullptr，否则为错误描述
+     */
+    static const char* invalidConfig(const UartConfig& config) noexcept {
+        bool validBaudRate = baudRateTable().count(config.baudRate) != 0;
+#ifdef UART_HAS_TERMIOS2
+        validBaudRate = validBaudRate || config.baudRate != 0;
+#endif
+
+        if (!validBaudRate) {
+            return "Invalid baud rate config";
+        }
+
+        if (config.dataBits < 5 || config.dataBits > 8) {
+            return "Invalid data bits config.";
+        }
+
+        if (config.stopBits != 1 && config.stopBits != 2) {
+            return "Invalid stop bits config.";
+        }
+
+        if (config.parity != 'N' && config.parity != 'E' && config.parity != 'O') {
+            return "Invalid parity config.";
+        }
+
+        return nullptr;
+    } /* static const char* invalidConfig(const UartConfig& config) noexcept { */
+
+    /**
+     * @brief 波特率与termios位图之间的映射
+     */
+    static const std::map<speed_t, speed_t>& baudRateTable() {
+        static const std::map<speed_t, speed_t> baudRateMap = {
+            {      0,       B0}, {     50,      B50}, {     75,      B75},
+            {    110,     B110}, {    134,     B134}, {    150,     B150},
+            {    200,     B200}, {    300,     B300}, {    600,     B600},
+            {   1200,    B1200}, {   1800,    B1800}, {   2400,    B2400},
+            {   4800,    B4800}, {   9600,    B9600}, {  19200,   B19200},
+            {  38400,   B38400}, {  57600,   B57600}, { 115200,  B115200},
+            { 230400,  B230400}, { 460800,  B460800}, { 500000,  B500000},
+            { 576000,  B576000}, { 921600,  B921600}, {1000000, B1000000},
+            {1152000, B1152000}, {1500000, B1500000}, {2000000, B2000000},
+            {2500000, B2500000}, {3000000, B3000000}, {3500000, B3500000},
+            {4000000, B4000000}
+        };
+
+        return baudRateMap;
+    }
+
+    /**
+     * @brief 比较两份配置的标志位与控制字符（波特率位于c_cflag中）
+     */
+    static bool sameAttributes(const struct termios& a, const struct termios& b) {
+        return a.c_iflag == b.c_iflag && a.c_oflag == b.c_oflag
+            && a.c_cflag == b.c_cflag && a.c_lflag == b.c_lflag
+            && std::memcmp(a.c_cc, b.c_cc, sizeof(a.c_cc)) == 0;
+    }
+
+    /**
+     * @brief 将_tty应用到串口，失败时抛出std::runtime_error
+     * @param when : 配置生效的时机，默认立即生效
+     */
+    void applyAttributes(When when = When::Now) {
+        if (tryApplyAttributes(when)) {
+            UART_THROW(std::runtime_error("Error in settring attributes."));
+        }
+    }
+
+    /**
+     * @brief 将_tty应用到串口，自定义波特率通过TCSETS2设置，随后读回驱动实际采用的波特率
+     * @param when : 配置生效的时机
+     * @return 成功时为空，失败时为对应的errno错误码
+     */
+    std::error_code tryApplyAttributes(When when) noexcept {
+        int action = when == When::Drain ? TCSADRAIN : when == When::Flush ? TCSAFLUSH : TCSANOW;
+
+#ifdef UART_HAS_TERMIOS2
+        struct termios2 tio;
+        unsigned long request = when == When::Drain ? TCSETSW2 : when == When::Flush ? TCSETSF2 : TCSETS2;
+
+        if (_customBaudRate) {
+            std::memset(&tio, 0, sizeof(tio));
+            tio.c_iflag  = _tty.c_iflag;
+            tio.c_oflag  = _tty.c_oflag;
+            tio.c_cflag  = (_tty.c_cflag & ~(CBAUD | CIBAUD)) | BOTHER; // 输入波特率与输出相同
+            tio.c_lflag  = _tty.c_lflag;
+            tio.c_line   = _tty.c_line;
+            std::memcpy(tio.c_cc, _tty.c_cc, sizeof(tio.c_cc));
+            tio.c_ispeed = _baudRate;
+            tio.c_ospeed = _baudRate;
+
+            if (ioctl(_fd.get(), request, &tio) == -1) {
+                return std::error_code(errno, std::generic_category());
+            }
+        } else if (tcsetattr(_fd.get(), action, &_tty) == -1) {
+            return std::error_code(errno, std::generic_category());
+        }
+
+        _actualBaudRate = ioctl(_fd.get(), TCGETS2, &tio) == 0 ? tio.c_ospeed : _baudRate;
+#else
+        if (tcsetattr(_fd.get(), action, &_tty) == -1) {
+            return std::error_code(errno, std::generic_category());
+        }
+
+        _actualBaudRate = _baudRate;
+#endif
+        return std::error_code();
+    } /* std::error_code tryApplyAttributes(When when) noexcept { */
+
+    /**
+     * @brief 阻塞读取策略下等待首个字节
+     * @return true表示可以读取，false表示超过读取超时仍无数据
+     * @note 未能打开阻塞文件描述符时从非阻塞的_fd读取，必须先等到数据，读取超时为-1时一直等待
+     */
+    bool waitReadable() const noexcept {
+        if (_readPolicy == ReadPolicy::Any || (_readTimeoutMs < 0 && _readFd.get() != -1)) {
+            return true;
+        }
+
+        struct pollfd pfd;
+        pfd.fd     = _fd.get();
+        pfd.events = POLLIN;
+
+        int ret;
+
+        do {
+            ret = ::poll(&pfd, 1, _readTimeoutMs);
+        } while (ret == -1 && errno == EINTR);
+
+        // poll()出错时交给随后的read()报告错误
+        return ret != 0;
+    }
+
+    /**
+     * @brief receive()等读取接口使用的文件描述符：阻塞读取策略下为_readFd，否则（或_readFd未能打开时）为_fd
+     */
+    int readFd() const noexcept {
+        return _readFd.get() != -1 ? _readFd.get() : _fd.get();
+    }
+
+    /**
+     * @brief 原始模式且VMIN=0时，无数据的read()返回0而非EAGAIN
+     */
+    bool emptyReadReturnsZero() const noexcept {
+        return _raw && _vmin == 0;
+    }
+
+    /**
+     * @brief 记录启用原始模式之前的输入、输出与本地标志，供configRawMode(false)恢复
+     */
+    void saveCookedFlags() noexcept {
+        _cookedIflag = _tty.c_iflag;
+        _cookedOflag = _tty.c_oflag;
+        _cookedLflag = _tty.c_lflag;
+    }
+
+    /**
+     * @brief 带截止时间的接收接口的参数检查
+     */
+    std::error_code checkReceive(const char* buffer) const noexcept {
+        if (!isOpen()) {
+            return std::make_error_code(std::errc::bad_file_descriptor);
+        }
+
+        if (buffer == nullptr) {
+            return std::make_error_code(std::errc::invalid_argument);
+        }
+
+        return std::error_code();
+    }
+
+    /**
+     * @brief 将相对等待时间换算为截止时间，溢出时视为一直等待
+     */
+    static Clock::time_point deadlineAfter(Clock::duration timeout) noexcept {
+        Clock::time_point now = Clock::now();
+
+        if (timeout > Clock::time_point::max() - now) {
+            return Clock::time_point::max();
+        }
+
+        return now + timeout;
+    }
+
+    /**
+     * @brief 用ppoll()等待串口可读，直到截止时间
+     * @return 为空表示可读；到期为std::errc::timed_out，其余为对应的errno错误码
+     * @note 每次被信号打断后都按单调时钟重新计算剩余时间，不会因重试而延后截止时间
+     */
+    std::error_code waitUntil(Clock::time_point deadline) const noexcept {
+        struct pollfd pfd;
+        pfd.fd     = _fd.get();
+        pfd.events = POLLIN;
+
+        for (;;) {
+            struct timespec ts;
+            struct timespec* timeout = nullptr;
+
+            if (deadline != Clock::time_point::max()) {
+                Clock::duration left = deadline - Clock::now();
+
+                if (left < Clock::duration::zero()) {
+                    left = Clock::duration::zero();
+                }
+
+                std::chrono::seconds sec = std::chrono::duration_cast<std::chrono::seconds>(left);
+                ts.tv_sec  = static_cast<time_t>(sec.count());
+                ts.tv_nsec = static_cast<long>(std::chrono::duration_cast<std::chrono::nanoseconds>(left - sec).count());
+                timeout    = &ts;
+            }
+
+            int ret = ::ppoll(&pfd, 1, timeout, nullptr);
+
+            if (ret > 0) {
+                // POLLHUP/POLLERR同样视为可读，由随后的read()报告
+                return std::error_code();
+            }
+
+            if (ret == 0) {
+                return std::make_error_code(std::errc::timed_out);
+            }
+
+            if (errno != EINTR) {
+                return std::error_code(errno, std::generic_category());
+            }
+        } /* for (;;) { */
+    } /* std::error_code waitUntil(Clock::time_point deadline) const noexcept { */
+
+    /**
+     * @brief 在截止时间前读到至少1个字节
+     * @param got : 输出，读到的字节数
+     * @note 先直接read()，已有数据时省去一次ppoll()
+     */
+    std::error_code readBefore(char* buffer, size_t length, Clock::time_point deadline, size_t& got) const noexcept {
+        bool polled = false;
+
+        for (;;) {
+            ssize_t result = read(_fd.get(), buffer, length);
+
+            if (result > 0) {
+                got = static_cast<size_t>(result);
+                return std::error_code();
+            }
+
+            if (result == 0) {
+                // VMIN=0时无数据也读到0，只有在ppoll()报告可读之后仍读到0才是对端关闭
+                if (!emptyReadReturnsZero() || polled) {
+                    return std::make_error_code(std::errc::connection_reset);
+                }
+            } else if (errno == EINTR) {
+                continue;
+            } else if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                return std::error_code(errno, std::generic_category());
+            }
+
+            polled = true;
+            std::error_code error = waitUntil(deadline);
+
+            if (error) {
+                return error;
+            }
+        } /* for (;;) { */
+    } /* std::error_code readBefore(char* buffer, size_t length, ...) const noexcept { */
+
     /**
      * @brief 配置串口
      */
     bool configure() {
+        // 先整体校验，-fno-exceptions下非法参数同样只返回false而不终止程序
+        const char* invalid = invalidConfig(getConfig());
+
+        if (invalid != nullptr) {
+            std::cerr << invalid << std::endl;
+            return false;
+        }
 
-        try {
+        UART_TRY {
             configBaudRate(_baudRate);
             configParity(_parity); // 无奇偶校验
             configStopBits(_stopBits); // 1个停止位
             configDataBits(_dataBits); // 8个数据位
             configHardwareFlowControl(_hfc); // 无硬件流控制
             configSoftwareFlowControl(_sfc); // 无软件流控制
-        } catch (std::invalid_argument& e) {
+
+            if (_raw) {
+                configRawMode(true, _vmin, _vtime); // 原始模式，与其他配置一起由一次tcsetattr()应用
+            }
+        } UART_CATCH(std::invalid_argument, e) {
             std::cerr << e.what() << std::endl;
             return false;
-        } catch (std::runtime_error& e) {
+        } UART_CATCH(std::runtime_error, e) {
             std::cerr << e.what() << std::endl;
             return false;
         }
@@ -451,10 +1707,27 @@ private:
         speed_t outputBaudRate = cfgetospeed(&tty);
 
         if (inputBaudRate != outputBaudRate) {
-            throw std::invalid_argument("Invalid termios struct in baud rate config.");
+            UART_THROW(std::invalid_argument("Invalid termios struct in baud rate config."));
         }
 
-        _baudRate = inputBaudRate;
+        // 将位图还原为实际的波特率
+        _baudRate       = 0;
+        _customBaudRate = false;
+        _actualBaudRate = 0;
+
+        const std::map<speed_t, speed_t>& baudRateMap = baudRateTable();
+
+        for (auto item = baudRateMap.begin(); item != baudRateMap.end(); ++item) {
+            if (item->second == outputBaudRate) {
+                _baudRate = item->first;
+                break;
+            }
+        }
+
+        // BOTHER表示自定义波特率，其大小只能通过TCGETS2读取，struct termios中没有记录
+        if (_baudRate == 0 && outputBaudRate != B0) {
+            UART_THROW(std::invalid_argument("Invalid termios struct in baud rate config."));
+        }
 
         // 解析数据位
         speed_t dataBitsMacro = tty.c_cflag & CSIZE;
@@ -473,7 +1746,7 @@ private:
                 _dataBits = 8;
                 break;
             default:
-                throw std::invalid_argument("Invalid termios struct in data bits config.");
+                UART_THROW(std::invalid_argument("Invalid termios struct in data bits config."));
         }
 
         // 解析停止位
@@ -504,24 +1777,40 @@ private:
         }
 
         // 解析软件流控制
-        if (tty.c_cflag & (IXON | IXOFF | IXANY)) {
+        if (tty.c_iflag & (IXON | IXOFF | IXANY)) {
             _sfc = true;
         } else {
             _sfc = false;
         }
-    }
 
-    const char* _port;   // 设备路径
-    speed_t _baudRate;   // 波特率
-    bool _hfc;           // 是否启用硬件流控制
-    bool _sfc;           // 是否启用软件流控制
-    char _parity;        // 是否启用奇偶校验
-    int _stopBits;       // 停止位数
-    int _dataBits;       // 数据位数
+        // 解析原始模式
+        _raw   = !(tty.c_lflag & ICANON);
+        _vmin  = tty.c_cc[VMIN];
+        _vtime = tty.c_cc[VTIME];
+    }
 
-    int _fd;             // tty设备的文件描述符
-    struct termios _tty; // tty设备的配置信息
-    bool _open;          // 串口是否已经打开
+    // 按对齐从大到小排列，减小对象体积，便于连续存放大量串口
+    std::unique_ptr<char[]> _port; // 设备路径
+    struct termios _tty;           // tty设备的配置信息
+    tcflag_t _cookedIflag;         // 启用原始模式之前的c_iflag
+    tcflag_t _cookedOflag;         // 启用原始模式之前的c_oflag
+    tcflag_t _cookedLflag;         // 启用原始模式之前的c_lflag
+    speed_t _baudRate;             // 波特率
+    speed_t _actualBaudRate;       // 驱动实际采用的波特率
+    int _readTimeoutMs;            // 阻塞读取策略下等待首个字节的超时（毫秒）
+    UartFd _fd;                    // tty设备的文件描述符（非阻塞）
+    UartFd _readFd;                // 阻塞读取策略使用的文件描述符，其余情况为-1
+    bool _customBaudRate;          // 是否为需要BOTHER设置的非标准波特率
+    bool _hfc;                     // 是否启用硬件流控制
+    bool _sfc;                     // 是否启用软件流控制
+    char _parity;                  // 是否启用奇偶校验
+    uint8_t _stopBits;             // 停止位数
+    uint8_t _dataBits;             // 数据位数
+    bool _raw;                     // 是否启用原始模式
+    cc_t _vmin;                    // 原始模式下的VMIN
+    cc_t _vtime;                   // 原始模式下的VTIME
+    ReadPolicy _readPolicy;        // 读取策略
+    bool _open;                    // 串口是否已经打开
 };
 
 #endif /* __UART_HPP */
@@ -0,0 +1,211 @@
+#ifndef __UART_ADAPTIVE_HPP
+#define __UART_ADAPTIVE_HPP
+
+// 标准库
+#include <chrono>
+#include <stdexcept>
+
+// 第三方库
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <time.h>
+#include <errno.h>
+
+#include "uart.hpp"
+
+/**
+ * @brief 自适应接收器，根据数据到达速率自动调整每次读取的批量大小
+ * @note 线路空闲或只有零星命令/应答时，数据一到就立即读取（安静模式），保证响应延迟；
+ *       突发大量数据时，根据估计的到达速率与内核输入队列（TIOCINQ）中的积压量，
+ *       在延迟上限内先等待更多数据到达再一次读出（批量模式），减少唤醒与系统调用次数。
+ *       距上次读取超过延迟上限才等到数据时视为线路曾经空闲，清零速率估计并回到安静模式，
+ *       突发结束后的第一个应答不会被批量等待拖慢。
+ *       串口应使用默认的ReadPolicy::Any（非阻塞）读取策略。
+ */
+class UartAdaptiveReceiver {
+public:
+    /**
+     * @brief 当前所处的工作模式
+     */
+    enum class Regime {
+        Quiet, // 安静模式：逐次立即读取
+        Bulk   // 批量模式：等待数据攒够后再读取
+    };
+
+    /**
+     * @brief 延迟与批量的配置
+     */
+    struct Config {
+        unsigned maxLatencyUs; // 批量模式下首字节到达后最多额外等待的时间（微秒）
+        size_t minBatch;       // 预计在maxLatencyUs内能攒到的字节数不少于该值时才进入批量模式
+        double smoothing;      // 到达速率指数滑动平均的系数（0~1），越大越灵敏
+    };
+
+    /**
+     * @brief 统计信息
+     */
+    struct Stats {
+        uint64_t reads;     // read()次数
+        uint64_t bytes;     // 读取的总字节数
+        uint64_t bulkReads; // 批量模式下的read()次数
+        double rate;        // 估计的到达速率（字节/秒）
+        Regime regime;      // 最近一次读取时所处的模式
+    };
+
+    /**
+     * @brief 构造函数
+     * @param uart   : 已打开的串口，其生命周期必须长于UartAdaptiveReceiver
+     * @param config : 配置，默认延迟上限2ms、最小批量64字节、平滑系数0.25
+     */
+    explicit UartAdaptiveReceiver(const Uart& uart, Config config = defaultConfig())
+        : _uart(uart)
+        , _config(config)
+        , _last(std::chrono::steady_clock::now()) {
+            if (config.smoothing <= 0 || config.smoothing > 1 || config.minBatch == 0) {
+                throw std::invalid_argument("Invalid adaptive receiver config.");
+            }
+
+            _stats.reads     = 0;
+            _stats.bytes     = 0;
+            _stats.bulkReads = 0;
+            _stats.rate      = 0;
+            _stats.regime    = Regime::Quiet;
+        } /* explicit UartAdaptiveReceiver(const Uart& uart, ...) { */
+
+    /**
+     * @brief 默认配置
+     */
+    static Config defaultConfig() {
+        Config config;
+        config.maxLatencyUs = 2000;
+        config.minBatch     = 64;
+        config.smoothing    = 0.25;
+        return config;
+    }
+
+    /**
+     * @brief 接收数据
+     * @param buffer    : 数据缓冲区基地址
+     * @param length    : 接收的数据的最大长度（单位：字节）
+     * @param timeoutMs : 等待首个字节的最长时间（毫秒），-1表示一直等待，默认为-1
+     * @return 接收的数据长度，超时返回0
+     * @note 不会在数据末尾写入'\0'
+     */
+    size_t receive(char* buffer, size_t length, int timeoutMs = -1) {
+        if (buffer == nullptr) {
+            throw std::invalid_argument("Buffer cannot be nullptr.");
+        }
+
+        if (!waitReadable(timeoutMs)) {
+            return 0;
+        }
+
+        // 速率只在读取后更新，线路空闲了超过延迟上限时旧的估计已失效
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+        if (now - _last > std::chrono::microseconds(_config.maxLatencyUs)) {
+            _stats.rate = 0;
+        }
+
+        int backlog = 0;
+
+        if (::ioctl(_uart.getFd(), TIOCINQ, &backlog) == -1) {
+            backlog = 0;
+        }
+
+        // 在延迟上限内预计能攒到足够多的数据才值得等待
+        double expected = _stats.rate * _config.maxLatencyUs / 1e6;
+        size_t target   = length < static_cast<size_t>(expected) ? length : static_cast<size_t>(expected);
+
+        // 模式只由到达速率决定；积压已达到目标（如高负载下内核队列已满）时仍处于批量模式，只是无需等待
+        _stats.regime = expected >= _config.minBatch ? Regime::Bulk : Regime::Quiet;
+
+        if (_stats.regime == Regime::Bulk && static_cast<size_t>(backlog) < target) {
+            double waitUs = (target - backlog) / _stats.rate * 1e6;
+            sleepUs(waitUs < _config.maxLatencyUs ? static_cast<unsigned>(waitUs) : _config.maxLatencyUs);
+        }
+
+        UartResult result = _uart.tryReceive(buffer, length);
+
+        if (!result.has_value()) {
+            if (result.error() == std::errc::operation_would_block) {
+                return 0;
+            }
+            throw std::runtime_error("Error in receiving data.");
+        }
+
+        update(*result);
+
+        return *result;
+    } /* size_t receive(char* buffer, size_t length, int timeoutMs = -1) { */
+
+    /**
+     * @brief 获取统计信息
+     */
+    const Stats& getStats() const {
+        return _stats;
+    }
+
+    /**
+     * @brief 获取当前所处的工作模式
+     */
+    Regime getRegime() const {
+        return _stats.regime;
+    }
+
+private:
+    bool waitReadable(int timeoutMs) const {
+        struct pollfd pfd;
+        pfd.fd     = _uart.getFd();
+        pfd.events = POLLIN;
+
+        int ret;
+
+        do {
+            ret = ::poll(&pfd, 1, timeoutMs);
+        } while (ret == -1 && errno == EINTR);
+
+        if (ret == -1) {
+            throw std::runtime_error("Error in waiting for data.");
+        }
+
+        return ret > 0;
+    }
+
+    static void sleepUs(unsigned us) {
+        struct timespec ts;
+        ts.tv_sec  = us / 1000000;
+        ts.tv_nsec = static_cast<long>(us % 1000000) * 1000;
+
+        while (::clock_nanosleep(CLOCK_MONOTONIC, 0, &ts, &ts) == EINTR) {
+        }
+    }
+
+    /**
+     * @brief 用本次读取的字节数与距上次读取的间隔更新到达速率
+     */
+    void update(size_t bytes) {
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        double elapsed = std::chrono::duration<double>(now - _last).count();
+        _last = now;
+
+        if (elapsed > 0) {
+            double instant = bytes / elapsed;
+            _stats.rate += _config.smoothing * (instant - _stats.rate);
+        }
+
+        _stats.reads += 1;
+        _stats.bytes += bytes;
+
+        if (_stats.regime == Regime::Bulk) {
+            _stats.bulkReads += 1;
+        }
+    } /* void update(size_t bytes) { */
+
+    const Uart& _uart;                             // 数据来源
+    Config _config;                                // 配置
+    Stats _stats;                                  // 统计信息
+    std::chrono::steady_clock::time_point _last;   // 上次读取的时间
+};
+
+#endif /* __UART_ADAPTIVE_HPP */
@@ -0,0 +1,261 @@
+#ifndef __UART_COBS_HPP
+#define __UART_COBS_HPP
+
+// 标准库
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include "uart.hpp"
+#include "uart_frame.hpp"
+#include "uart_simd.hpp"
+#include "uart_transport.hpp"
+
+/**
+ * @brief COBS编码后的最大长度，含结尾的0x00分隔符
+ * @param length : 原始数据的长度（单位：字节）
+ */
+inline size_t uartCobsMaxEncodedSize(size_t length) {
+    return length + length / 254 + 2;
+}
+
+/**
+ * @brief COBS编码，并在结尾追加0x00分隔符
+ * @param data   : 原始数据的基地址
+ * @param length : 原始数据的长度（单位：字节）
+ * @param out    : 输出缓冲区，至少uartCobsMaxEncodedSize(length)字节，不能与data重叠
+ * @return 写入out的字节数（含分隔符）
+ * @note 用uartFindByte()在每个至多254字节的块内查找0x00，块内数据整段memcpy，
+ *       输出与逐字节的参考实现逐字节相同
+ */
+inline size_t uartCobsEncode(const char* data, size_t length, char* out) {
+    const char* p   = data;
+    const char* end = data + length;
+    char* dest      = out;
+
+    for (;;) {
+        const char* limit = end - p > 254 ? p + 254 : end;
+        const char* zero  = uartFindByte(p, limit, '\0');
+        size_t count      = zero - p;
+
+        // 满块（254字节且无0x00）的长度字节恰好是0xFF
+        *dest++ = static_cast<char>(count + 1);
+        std::memcpy(dest, p, count);
+        dest += count;
+
+        if (zero != limit) {
+            // 0x00由块长度隐含表示，跳过
+            p = zero + 1;
+        } else if (count == 254) {
+            // 满块之后没有隐含的0x00
+            p = limit;
+        } else {
+            break;
+        }
+    } /* for (;;) { */
+
+    *dest++ = '\0';
+    return dest - out;
+} /* inline size_t uartCobsEncode(...) { */
+
+/**
+ * @brief COBS解码
+ * @param data    : 一帧编码后的数据，不含0x00分隔符
+ * @param length  : data的长度（单位：字节）
+ * @param out     : 输出缓冲区，至少length字节；可以等于data以就地解码
+ * @param decoded : 输出，解码后的长度
+ * @return 解码成功返回true；帧内出现0x00或块长度越界时返回false
+ */
+inline bool uartCobsDecode(const char* data, size_t length, char* out, size_t& decoded) {
+    size_t in  = 0;
+    size_t pos = 0;
+
+    if (uartFindByte(data, data + length, '\0') != data + length) {
+        return false;
+    }
+
+    while (in < length) {
+        size_t code = static_cast<unsigned char>(data[in]);
+
+        if (code == 0 || in + code > length) {
+            return false;
+        }
+
+        // 就地解码时输出始终落后于输入，memmove可以处理重叠
+        std::memmove(out + pos, data + in + 1, code - 1);
+        pos += code - 1;
+        in  += code;
+
+        if (code != 0xFF && in < length) {
+            out[pos++] = '\0';
+        }
+    } /* while (in < length) { */
+
+    decoded = pos;
+    return true;
+} /* inline bool uartCobsDecode(...) { */
+
+/**
+ * @brief 在UartTxQueue的槽位中直接编码一帧
+ * @param queue  : 发送队列，maxMessageSize不小于uartCobsMaxEncodedSize(length)
+ * @param data   : 原始数据的基地址
+ * @param length : 原始数据的长度（单位：字节）
+ * @return 与UartTxQueue::send()相同
+ */
+template <typename Queue>
+bool uartCobsEnqueue(Queue& queue, const char* data, size_t length) {
+    if (data == nullptr) {
+        throw std::invalid_argument("Data cannot be nullptr.");
+    }
+
+    return queue.emplace(uartCobsMaxEncodedSize(length), [data, length](char* slot) {
+        return uartCobsEncode(data, length, slot);
+    });
+}
+
+/**
+ * @brief COBS帧发送器
+ * @note 构造时按最大帧长分配发送缓冲区，之后每帧直接编码进该缓冲区再写入串口，不再分配内存。
+ *       Transport为const Uart（即UartCobsWriter）或UartTransport的派生类
+ */
+template <typename Transport>
+class UartBasicCobsWriter {
+public:
+    /**
+     * @brief 构造函数
+     * @param transport    : 发送目标，例如已打开的串口，其生命周期必须长于发送器
+     * @param maxFrameSize : 原始帧的最大长度（单位：字节），默认为4096
+     */
+    explicit UartBasicCobsWriter(Transport& transport, size_t maxFrameSize = 4096)
+        : _transport(transport)
+        , _buffer(uartCobsMaxEncodedSize(maxFrameSize))
+        , _maxFrameSize(maxFrameSize) {}
+
+    /**
+     * @brief 编码并发送一帧，串口不可写时等待
+     * @param data   : 原始数据的基地址
+     * @param length : 原始数据的长度（单位：字节），不能超过maxFrameSize
+     * @return 写入串口的字节数（含分隔符）
+     * @note 参数错误时抛出std::invalid_argument，发送出错时抛出std::runtime_error
+     */
+    size_t send(const char* data, size_t length) {
+        if (data == nullptr) {
+            throw std::invalid_argument("Data cannot be nullptr.");
+        }
+
+        if (length > _maxFrameSize) {
+            throw std::invalid_argument("Frame exceeds the maximum frame size.");
+        }
+
+        size_t total = uartCobsEncode(data, length, _buffer.data());
+        size_t sent  = 0;
+
+        while (sent < total) {
+            UartResult result = UartIo<Transport>::write(_transport, _buffer.data() + sent, total - sent);
+
+            if (result.has_value()) {
+                sent += *result;
+            } else if (result.error() == std::errc::operation_would_block) {
+                UartIo<Transport>::waitWritable(_transport);
+            } else {
+                throw std::runtime_error("Error in sending data.");
+            }
+        } /* while (sent < total) { */
+
+        return total;
+    } /* size_t send(const char* data, size_t length) { */
+
+private:
+    Transport& _transport;     // 发送目标
+    std::vector<char> _buffer; // 发送缓冲区
+    size_t _maxFrameSize;      // 原始帧的最大长度
+};
+
+/**
+ * @brief COBS帧接收器
+ * @note 以0x00为分隔符通过UartBasicFrameReader切分，然后在接收缓冲区内就地解码，不做拷贝。
+ *       返回的帧在下一次调用next()/nextUntil()之前有效，解码失败的帧被丢弃并计入getErrors()。
+ *       Transport为const Uart（即UartCobsReader）或UartTransport的派生类
+ */
+template <typename Transport>
+class UartBasicCobsReader {
+public:
+    /**
+     * @brief 构造函数
+     * @param transport : 数据来源，例如已打开的串口，其生命周期必须长于接收器
+     * @param capacity  : 接收缓冲区大小，即最长的编码后帧（含分隔符）的长度，默认为65536
+     */
+    explicit UartBasicCobsReader(Transport& transport, size_t capacity = 65536)
+        : _reader(transport, '\0', capacity, true)
+        , _errors(0) {}
+
+    /**
+     * @brief 取出下一帧（非阻塞）
+     * @param frame : 输出，解码后的帧
+     * @return 取到完整的帧返回true；暂无完整的帧返回false
+     * @note 异常与UartBasicFrameReader::next()相同
+     */
+    bool next(UartSpan& frame) {
+        char* data;
+        size_t size;
+
+        while (_reader.next(data, size)) {
+            if (decode(data, size, frame)) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /**
+     * @brief 在截止时间前取出下一帧
+     * @param frame    : 输出，解码后的帧
+     * @param deadline : 截止时间，Uart::Clock::time_point::max()表示一直等待
+     * @return 取到完整的帧返回true；超时返回false
+     * @note 异常与UartBasicFrameReader::nextUntil()相同
+     */
+    bool nextUntil(UartSpan& frame, Uart::Clock::time_point deadline) {
+        char* data;
+        size_t size;
+
+        while (_reader.nextUntil(data, size, deadline)) {
+            if (decode(data, size, frame)) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /**
+     * @brief 获取解码失败而被丢弃的帧数
+     */
+    uint64_t getErrors() const {
+        return _errors;
+    }
+
+private:
+    bool decode(char* data, size_t size, UartSpan& frame) {
+        size_t decoded;
+
+        if (!uartCobsDecode(data, size, data, decoded)) {
+            ++_errors;
+            return false;
+        }
+
+        frame.data = data;
+        frame.size = decoded;
+        return true;
+    }
+
+    UartBasicFrameReader<Transport> _reader; // 按0x00切分
+    uint64_t _errors;                        // 解码失败的帧数
+};
+
+typedef UartBasicCobsWriter<const Uart> UartCobsWriter;
+typedef UartBasicCobsReader<const Uart> UartCobsReader;
+
+#endif /* __UART_COBS_HPP */
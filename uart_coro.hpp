@@ -0,0 +1,716 @@
+#ifndef __UART_CORO_HPP
+#define __UART_CORO_HPP
+
+#if __cplusplus < 202002L
+#error "uart_coro.hpp requires C++20."
+#endif
+
+// 标准库
+#include <algorithm>
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// 第三方库
+#include <sys/epoll.h>
+#include <unistd.h>
+#include <errno.h>
+
+#include "uart.hpp"
+
+class UartEventLoop;
+class AsyncUart;
+
+/**
+ * @brief 协程帧内存池
+ * @note 按64字节粒度分级的线程局部空闲链表，协程帧释放后回收到当前线程的链表中复用，
+ *       稳定运行后每次发起异步操作都不再访问全局堆。超过4KB的帧直接使用全局堆。
+ *       回收的内存不会归还给系统。
+ */
+class UartFramePool {
+public:
+    static void* allocate(size_t size) {
+        size_t cls = sizeClass(size);
+
+        if (cls >= kClasses) {
+            return ::operator new(size);
+        }
+
+        Node*& head = freeList(cls);
+
+        if (head != nullptr) {
+            Node* node = head;
+            head = node->next;
+            return node;
+        }
+
+        return ::operator new(cls * kGranule);
+    } /* static void* allocate(size_t size) { */
+
+    static void deallocate(void* ptr, size_t size) noexcept {
+        size_t cls = sizeClass(size);
+
+        if (cls >= kClasses) {
+            ::operator delete(ptr);
+            return;
+        }
+
+        Node* node = static_cast<Node*>(ptr);
+        node->next = freeList(cls);
+        freeList(cls) = node;
+    }
+
+private:
+    struct Node {
+        Node* next;
+    };
+
+    static constexpr size_t kGranule = 64; // 分级粒度
+    static constexpr size_t kClasses = 65; // 分级数，最大4KB
+
+    static size_t sizeClass(size_t size) noexcept {
+        return (size + kGranule - 1) / kGranule;
+    }
+
+    static Node*& freeList(size_t cls) noexcept {
+        thread_local Node* lists[kClasses] = {};
+        return lists[cls];
+    }
+};
+
+/**
+ * @brief 协程promise的公共部分：帧内存池、延续与分离运行
+ */
+struct UartPromiseBase {
+    std::coroutine_handle<> continuation; // 等待本协程的协程
+    std::exception_ptr exception;         // 协程体抛出的异常
+    int* liveTasks = nullptr;             // 分离运行时所属事件循环的任务计数，非空表示已分离
+
+    static void* operator new(size_t size) {
+        return UartFramePool::allocate(size);
+    }
+
+    static void operator delete(void* ptr, size_t size) noexcept {
+        UartFramePool::deallocate(ptr, size);
+    }
+
+    /**
+     * @brief 结束时恢复等待者；分离运行的协程自行销毁
+     */
+    struct FinalAwaiter {
+        bool await_ready() const noexcept {
+            return false;
+        }
+
+        template <typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+            UartPromiseBase& promise = handle.promise();
+
+            if (promise.continuation) {
+                return promise.continuation;
+            }
+
+            if (promise.liveTasks != nullptr) {
+                if (promise.exception) {
+                    std::terminate(); // 分离运行的协程没有人能接收异常
+                }
+
+                --*promise.liveTasks;
+                handle.destroy();
+            }
+
+            return std::noop_coroutine();
+        }
+
+        void await_resume() const noexcept {
+        }
+    };
+
+    std::suspend_always initial_suspend() const noexcept {
+        return {};
+    }
+
+    FinalAwaiter final_suspend() const noexcept {
+        return {};
+    }
+
+    void unhandled_exception() noexcept {
+        exception = std::current_exception();
+    }
+};
+
+/**
+ * @brief 惰性启动的协程任务
+ * @note 被co_await或交给UartEventLoop::spawn()时才开始运行
+ */
+template <typename T = void>
+class UartTask {
+public:
+    struct promise_type : UartPromiseBase {
+        T value;
+
+        UartTask get_return_object() {
+            return UartTask(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        void return_value(T v) {
+            value = std::move(v);
+        }
+    };
+
+    UartTask(UartTask&& other) noexcept : _handle(std::exchange(other._handle, nullptr)) {}
+
+    UartTask& operator=(UartTask&& other) noexcept {
+        if (this != &other) {
+            reset();
+            _handle = std::exchange(other._handle, nullptr);
+        }
+        return *this;
+    }
+
+    ~UartTask() {
+        reset();
+    }
+
+    bool await_ready() const noexcept {
+        return false;
+    }
+
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+        _handle.promise().continuation = awaiting;
+        return _handle;
+    }
+
+    T await_resume() {
+        if (_handle.promise().exception) {
+            std::rethrow_exception(_handle.promise().exception);
+        }
+        return std::move(_handle.promise().value);
+    }
+
+private:
+    friend class UartEventLoop;
+
+    explicit UartTask(std::coroutine_handle<promise_type> handle) : _handle(handle) {}
+
+    void reset() {
+        if (_handle) {
+            _handle.destroy();
+            _handle = nullptr;
+        }
+    }
+
+    std::coroutine_handle<promise_type> _handle;
+};
+
+template <>
+class UartTask<void> {
+public:
+    struct promise_type : UartPromiseBase {
+        UartTask get_return_object() {
+            return UartTask(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        void return_void() noexcept {
+        }
+    };
+
+    UartTask(UartTask&& other) noexcept : _handle(std::exchange(other._handle, nullptr)) {}
+
+    UartTask& operator=(UartTask&& other) noexcept {
+        if (this != &other) {
+            reset();
+            _handle = std::exchange(other._handle, nullptr);
+        }
+        return *this;
+    }
+
+    ~UartTask() {
+        reset();
+    }
+
+    bool await_ready() const noexcept {
+        return false;
+    }
+
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+        _handle.promise().continuation = awaiting;
+        return _handle;
+    }
+
+    void await_resume() {
+        if (_handle.promise().exception) {
+            std::rethrow_exception(_handle.promise().exception);
+        }
+    }
+
+private:
+    friend class UartEventLoop;
+
+    explicit UartTask(std::coroutine_handle<promise_type> handle) : _handle(handle) {}
+
+    void reset() {
+        if (_handle) {
+            _handle.destroy();
+            _handle = nullptr;
+        }
+    }
+
+    std::coroutine_handle<promise_type> _handle;
+};
+
+/**
+ * @brief 驱动协程的epoll事件循环
+ * @note 每个AsyncUart只在创建时以边沿触发方式注册一次，之后的异步读写不再调用epoll_ctl()。
+ *       单线程运行，成千上万个协议会话可以由一个线程驱动；需要更多线程时每个线程各用一个事件循环。
+ */
+class UartEventLoop {
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    UartEventLoop()
+        : _epfd(-1)
+        , _liveTasks(0)
+        , _stopped(false)
+        , _events(256) {
+            _epfd = ::epoll_create1(EPOLL_CLOEXEC);
+
+            if (_epfd == -1) {
+                throw std::runtime_error("Error in creating epoll instance.");
+            }
+        }
+
+    ~UartEventLoop() {
+        ::close(_epfd);
+    }
+
+    UartEventLoop(const UartEventLoop&)            = delete;
+    UartEventLoop& operator=(const UartEventLoop&) = delete;
+
+    /**
+     * @brief 分离运行一个协程任务，立即执行到第一个挂起点
+     * @note 任务结束后自行销毁；任务抛出未捕获的异常时调用std::terminate()
+     */
+    void spawn(UartTask<void> task) {
+        std::coroutine_handle<UartTask<void>::promise_type> handle = std::exchange(task._handle, nullptr);
+        handle.promise().liveTasks = &_liveTasks;
+        ++_liveTasks;
+        handle.resume();
+    }
+
+    /**
+     * @brief 运行事件循环，直到所有分离运行的任务结束或调用stop()
+     */
+    void run() {
+        _stopped = false;
+
+        while (_liveTasks > 0 && !_stopped) {
+            runOnce(-1);
+        }
+    }
+
+    /**
+     * @brief 使run()在本轮事件处理完后返回
+     * @note 只能在事件循环所在线程（例如协程中）调用
+     */
+    void stop() {
+        _stopped = true;
+    }
+
+    /**
+     * @brief 等待一次事件并恢复就绪的协程
+     * @param timeoutMs : 最长等待时间（毫秒），-1表示一直等待（有定时器时等到最近的超时）
+     */
+    void runOnce(int timeoutMs);
+
+    /**
+     * @brief 获取尚未结束的分离任务数
+     */
+    int getLiveTasks() const {
+        return _liveTasks;
+    }
+
+private:
+    friend class AsyncUart;
+
+    /**
+     * @brief 接收超时定时器，每个AsyncUart在堆中最多占一个位置
+     */
+    struct Timer {
+        Clock::time_point deadline;
+        AsyncUart* port;
+    };
+
+    static constexpr size_t kNoTimer = static_cast<size_t>(-1); // 不在定时器堆中
+
+    void add(AsyncUart* port, int fd) {
+        if (fd < 0) {
+            throw std::invalid_argument("Invalid UART file descriptor.");
+        }
+
+        if (static_cast<size_t>(fd) >= _ports.size()) {
+            _ports.resize(fd + 1, nullptr);
+        }
+
+        struct epoll_event ev = {};
+        ev.events  = EPOLLIN | EPOLLOUT | EPOLLET;
+        ev.data.fd = fd;
+
+        if (::epoll_ctl(_epfd, EPOLL_CTL_ADD, fd, &ev) == -1) {
+            throw std::runtime_error("Error in registering UART port.");
+        }
+
+        _ports[fd] = port;
+    }
+
+    /**
+     * @brief 注销串口
+     * @note fd是注册时记录的值；该位置已被其他串口复用时不做任何事
+     */
+    void remove(AsyncUart* port, int fd) noexcept {
+        if (fd < 0 || static_cast<size_t>(fd) >= _ports.size() || _ports[fd] != port) {
+            return;
+        }
+
+        // 设备已关闭时内核已自动移出epoll，这里的失败可以忽略
+        ::epoll_ctl(_epfd, EPOLL_CTL_DEL, fd, nullptr);
+        _ports[fd] = nullptr;
+    }
+
+    /**
+     * @brief 设置串口的接收超时，串口已有定时器时原地更新截止时间
+     */
+    void setTimer(AsyncUart* port, Clock::time_point deadline);
+
+    /**
+     * @brief 从堆中删除串口的定时器，接收完成或串口销毁时调用
+     */
+    void cancelTimer(AsyncUart* port);
+
+    AsyncUart* find(int fd) const {
+        return static_cast<size_t>(fd) < _ports.size() ? _ports[fd] : nullptr;
+    }
+
+    void expireTimers();
+    void place(size_t index, const Timer& timer);
+    void siftUp(size_t index);
+    void siftDown(size_t index);
+
+    int _epfd;                               // epoll实例
+    int _liveTasks;                          // 尚未结束的分离任务数
+    bool _stopped;                           // 是否已请求停止
+    std::vector<struct epoll_event> _events; // epoll_wait的输出缓冲区
+    std::vector<AsyncUart*> _ports;          // 以fd为下标的注册表
+    std::vector<Timer> _timers;              // 按截止时间排列的最小堆，串口记录自己所在的下标
+};
+
+/**
+ * @brief 可在协程中co_await的异步串口
+ * @note 同一时刻最多只能有一个asyncReceive()与一个asyncSend()在等待。
+ *       串口应使用默认的ReadPolicy::Any（非阻塞）读取策略。
+ *       销毁时仍在等待的asyncReceive()/asyncSend()会被恢复并抛出std::runtime_error，
+ *       恢复后的协程不能再访问该AsyncUart。
+ */
+class AsyncUart {
+public:
+    typedef UartEventLoop::Clock Clock;
+
+    /**
+     * @brief 构造函数
+     * @param loop : 驱动该串口的事件循环
+     * @param uart : 已打开的串口，其生命周期必须长于AsyncUart
+     */
+    AsyncUart(UartEventLoop& loop, const Uart& uart)
+        : _loop(loop)
+        , _uart(uart)
+        , _fd(uart.getFd())
+        , _timerSlot(UartEventLoop::kNoTimer)
+        , _timedOut(false)
+        , _closed(false) {
+            if (!_uart.isOpen()) {
+                throw std::runtime_error("UART port is not open.");
+            }
+
+            _loop.add(this, _fd);
+        }
+
+    ~AsyncUart() {
+        _loop.cancelTimer(this);
+        // 串口可能已先关闭或被移走，用注册时记录的fd注销
+        _loop.remove(this, _fd);
+        _closed = true;
+
+        if (_reader) {
+            std::exchange(_reader, nullptr).resume();
+        }
+
+        if (_writer) {
+            std::exchange(_writer, nullptr).resume();
+        }
+    }
+
+    AsyncUart(const AsyncUart&)            = delete;
+    AsyncUart& operator=(const AsyncUart&) = delete;
+
+    /**
+     * @brief 异步发送全部数据
+     * @param data : 需要发送的数据，完成之前必须保持有效
+     * @return 发送的数据长度
+     */
+    UartTask<size_t> asyncSend(std::span<const std::byte> data) {
+        const char* base = reinterpret_cast<const char*>(data.data());
+        size_t sent = 0;
+
+        while (sent < data.size()) {
+            UartResult result = _uart.trySend(base + sent, data.size() - sent);
+
+            if (result.has_value()) {
+                sent += *result;
+                continue;
+            }
+
+            if (result.error() != std::errc::operation_would_block) {
+                throw std::runtime_error("Error in sending data.");
+            }
+
+            co_await WaitWritable{*this};
+        }
+
+        co_return sent;
+    } /* UartTask<size_t> asyncSend(std::span<const std::byte> data) { */
+
+    /**
+     * @brief 异步接收数据
+     * @param buffer   : 数据缓冲区
+     * @param deadline : 截止时间，默认为一直等待
+     * @return 接收的数据长度，超时或对端关闭时返回0
+     */
+    UartTask<size_t> asyncReceive(std::span<std::byte> buffer, Clock::time_point deadline = Clock::time_point::max()) {
+        char* base = reinterpret_cast<char*>(buffer.data());
+
+        for (;;) {
+            UartResult result = _uart.tryReceive(base, buffer.size());
+
+            if (result.has_value()) {
+                co_return *result;
+            }
+
+            if (result.error() != std::errc::operation_would_block) {
+                throw std::runtime_error("Error in receiving data.");
+            }
+
+            if (!co_await WaitReadable{*this, deadline}) {
+                co_return 0;
+            }
+        } /* for (;;) { */
+    } /* UartTask<size_t> asyncReceive(...) { */
+
+private:
+    friend class UartEventLoop;
+
+    struct WaitReadable {
+        AsyncUart& port;
+        Clock::time_point deadline;
+
+        bool await_ready() const noexcept {
+            return false;
+        }
+
+        void await_suspend(std::coroutine_handle<> handle) {
+            port._reader   = handle;
+            port._timedOut = false;
+
+            if (deadline != Clock::time_point::max()) {
+                port._loop.setTimer(&port, deadline);
+            }
+        }
+
+        /**
+         * @return true表示可读，false表示超时
+         */
+        bool await_resume() const {
+            if (port._closed) {
+                throw std::runtime_error("UART port is closed.");
+            }
+            return !port._timedOut;
+        }
+    };
+
+    struct WaitWritable {
+        AsyncUart& port;
+
+        bool await_ready() const noexcept {
+            return false;
+        }
+
+        void await_suspend(std::coroutine_handle<> handle) noexcept {
+            port._writer = handle;
+        }
+
+        void await_resume() const {
+            if (port._closed) {
+                throw std::runtime_error("UART port is closed.");
+            }
+        }
+    };
+
+    void resumeReader() {
+        if (_reader) {
+            _loop.cancelTimer(this);
+            std::exchange(_reader, nullptr).resume();
+        }
+    }
+
+    void resumeWriter() {
+        if (_writer) {
+            std::exchange(_writer, nullptr).resume();
+        }
+    }
+
+    void timeout() {
+        _timedOut = true;
+        std::exchange(_reader, nullptr).resume();
+    }
+
+    UartEventLoop& _loop;            // 所属事件循环
+    const Uart& _uart;               // 串口
+    std::coroutine_handle<> _reader; // 等待可读的协程
+    std::coroutine_handle<> _writer; // 等待可写的协程
+    int _fd;                         // 注册到事件循环时的文件描述符
+    size_t _timerSlot;               // 接收超时定时器在堆中的下标，kNoTimer表示没有
+    bool _timedOut;                  // 最近一次等待是否超时
+    bool _closed;                    // 是否正在销毁
+};
+
+inline void UartEventLoop::runOnce(int timeoutMs) {
+    if (!_timers.empty()) {
+        Clock::duration left = _timers.front().deadline - Clock::now();
+        int timerMs = left.count() > 0
+                    ? static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(left).count()) + 1
+                    : 0;
+
+        if (timeoutMs < 0 || timerMs < timeoutMs) {
+            timeoutMs = timerMs;
+        }
+    }
+
+    int n = ::epoll_wait(_epfd, _events.data(), static_cast<int>(_events.size()), timeoutMs);
+
+    if (n == -1 && errno != EINTR) {
+        throw std::runtime_error("Error in waiting for events.");
+    }
+
+    for (int i = 0; i < n; ++i) {
+        int fd = _events[i].data.fd;
+
+        uint32_t events = _events[i].events;
+
+        // 恢复的协程可能销毁该串口，因此每次恢复前都重新查表
+        if ((events & (EPOLLIN | EPOLLERR | EPOLLHUP)) && find(fd) != nullptr) {
+            find(fd)->resumeReader();
+        }
+
+        if ((events & (EPOLLOUT | EPOLLERR | EPOLLHUP)) && find(fd) != nullptr) {
+            find(fd)->resumeWriter();
+        }
+    }
+
+    expireTimers();
+} /* inline void UartEventLoop::runOnce(int timeoutMs) { */
+
+inline void UartEventLoop::expireTimers() {
+    Clock::time_point now = Clock::now();
+
+    while (!_timers.empty() && _timers.front().deadline <= now) {
+        AsyncUart* port = _timers.front().port;
+        cancelTimer(port);
+        port->timeout();
+    }
+}
+
+inline void UartEventLoop::setTimer(AsyncUart* port, Clock::time_point deadline) {
+    if (port->_timerSlot == kNoTimer) {
+        _timers.push_back(Timer{deadline, port});
+        port->_timerSlot = _timers.size() - 1;
+        siftUp(port->_timerSlot);
+        return;
+    }
+
+    size_t index = port->_timerSlot;
+    _timers[index].deadline = deadline;
+    siftUp(index);
+    siftDown(port->_timerSlot);
+}
+
+inline void UartEventLoop::cancelTimer(AsyncUart* port) {
+    size_t index = port->_timerSlot;
+
+    if (index == kNoTimer) {
+        return;
+    }
+
+    port->_timerSlot = kNoTimer;
+    Timer last = _timers.back();
+    _timers.pop_back();
+
+    if (index < _timers.size()) {
+        place(index, last);
+        siftUp(index);
+        siftDown(last.port->_timerSlot);
+    }
+} /* inline void UartEventLoop::cancelTimer(AsyncUart* port) { */
+
+inline void UartEventLoop::place(size_t index, const Timer& timer) {
+    _timers[index] = timer;
+    timer.port->_timerSlot = index;
+}
+
+inline void UartEventLoop::siftUp(size_t index) {
+    Timer timer = _timers[index];
+
+    while (index > 0) {
+        size_t parent = (index - 1) / 2;
+
+        if (!(timer.deadline < _timers[parent].deadline)) {
+            break;
+        }
+
+        place(index, _timers[parent]);
+        index = parent;
+    }
+
+    place(index, timer);
+}
+
+inline void UartEventLoop::siftDown(size_t index) {
+    Timer timer = _timers[index];
+    size_t size = _timers.size();
+
+    for (;;) {
+        size_t child = index * 2 + 1;
+
+        if (child >= size) {
+            break;
+        }
+
+        if (child + 1 < size && _timers[child + 1].deadline < _timers[child].deadline) {
+            ++child;
+        }
+
+        if (!(_timers[child].deadline < timer.deadline)) {
+            break;
+        }
+
+        place(index, _timers[child]);
+        index = child;
+    } /* for (;;) { */
+
+    place(index, timer);
+} /* inline void UartEventLoop::siftDown(size_t index) { */
+
+#endif /* __UART_CORO_HPP */
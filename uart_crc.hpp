@@ -0,0 +1,467 @@
+#ifndef __UART_CRC_HPP
+#define __UART_CRC_HPP
+
+// 标准库
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define UART_CRC_PCLMUL 1
+#elif defined(__aarch64__)
+#include <arm_acle.h>
+#include <sys/auxv.h>
+#define UART_CRC_ARMV8 1
+#ifndef HWCAP_CRC32
+#define HWCAP_CRC32 (1 << 7)
+#endif
+#if defined(__clang__)
+#define UART_CRC_TARGET_ARMV8 __attribute__((target("crc")))
+#else
+#define UART_CRC_TARGET_ARMV8 __attribute__((target("+crc")))
+#endif
+#endif
+
+#include "uart.hpp"
+
+/**
+ * @brief CRC-32使用的硬件加速
+ */
+enum class UartCrcAccel {
+    None,   // slice-by-8查表
+    Pclmul, // x86 PCLMULQDQ折叠，每次64字节
+    Armv8   // ARMv8 CRC32指令，每次8字节
+};
+
+/**
+ * @brief 当前CPU支持的CRC-32硬件加速，首次调用时检测
+ */
+inline UartCrcAccel uartCrcAccel() {
+#if defined(UART_CRC_PCLMUL)
+    static const UartCrcAccel accel = __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse4.1")
+                                    ? UartCrcAccel::Pclmul : UartCrcAccel::None;
+    return accel;
+#elif defined(UART_CRC_ARMV8)
+    static const UartCrcAccel accel = (getauxval(AT_HWCAP) & HWCAP_CRC32) ? UartCrcAccel::Armv8 : UartCrcAccel::None;
+    return accel;
+#else
+    return UartCrcAccel::None;
+#endif
+}
+
+/**
+ * @brief slice-by-8查找表，t[k][i]为字节i之后再跟k个0x00字节时对CRC寄存器的贡献
+ * @tparam Reflected : 是否为反射（LSB先行）CRC
+ * @note 首次使用时生成，之后只读
+ */
+template <typename T, T Poly, bool Reflected>
+struct UartCrcTable {
+    T t[8][256];
+
+    UartCrcTable() {
+        const unsigned width = sizeof(T) * 8;
+        const T top          = static_cast<T>(T(1) << (width - 1));
+
+        for (unsigned i = 0; i < 256; ++i) {
+            T crc = Reflected ? static_cast<T>(i) : static_cast<T>(i << (width - 8));
+
+            for (int bit = 0; bit < 8; ++bit) {
+                if (Reflected) {
+                    crc = (crc & 1) ? static_cast<T>((crc >> 1) ^ Poly) : static_cast<T>(crc >> 1);
+                } else {
+                    crc = (crc & top) ? static_cast<T>((crc << 1) ^ Poly) : static_cast<T>(crc << 1);
+                }
+            }
+
+            t[0][i] = crc;
+        } /* for (unsigned i = 0; i < 256; ++i) { */
+
+        for (unsigned k = 1; k < 8; ++k) {
+            for (unsigned i = 0; i < 256; ++i) {
+                T prev = t[k - 1][i];
+                t[k][i] = Reflected ? static_cast<T>((prev >> 8) ^ t[0][prev & 0xFF])
+                                    : static_cast<T>((prev << 8) ^ t[0][prev >> (width - 8)]);
+            }
+        }
+    } /* UartCrcTable() { */
+
+    static const UartCrcTable& get() {
+        static const UartCrcTable table;
+        return table;
+    }
+};
+
+/**
+ * @brief 反射CRC的slice-by-8实现，每次处理8字节
+ * @tparam Copy : 是否同时把数据拷贝到out（拷贝与计算在同一遍内完成）
+ * @param crc : CRC寄存器的当前值（不含输出异或）
+ */
+template <typename T, T Poly, bool Copy>
+T uartCrcSlice8Reflected(T crc, const char* data, size_t length, char* out) {
+    const T (*t)[256] = UartCrcTable<T, Poly, true>::get().t;
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(data);
+
+    while (length >= 8) {
+        uint64_t word;
+        std::memcpy(&word, p, 8);
+
+        if (Copy) {
+            std::memcpy(out, &word, 8);
+            out += 8;
+        }
+
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        word = __builtin_bswap64(word);
+#endif
+        word ^= crc;
+        crc = t[7][word & 0xFF]         ^ t[6][(word >> 8) & 0xFF]
+            ^ t[5][(word >> 16) & 0xFF] ^ t[4][(word >> 24) & 0xFF]
+            ^ t[3][(word >> 32) & 0xFF] ^ t[2][(word >> 40) & 0xFF]
+            ^ t[1][(word >> 48) & 0xFF] ^ t[0][word >> 56];
+
+        p      += 8;
+        length -= 8;
+    } /* while (length >= 8) { */
+
+    while (length-- > 0) {
+        unsigned char byte = *p++;
+
+        if (Copy) {
+            *out++ = static_cast<char>(byte);
+        }
+
+        crc = static_cast<T>(t[0][(crc ^ byte) & 0xFF] ^ (crc >> 8));
+    }
+
+    return crc;
+} /* T uartCrcSlice8Reflected(...) { */
+
+/**
+ * @brief 非反射（MSB先行）16位CRC的slice-by-8实现
+ * @note 参数与uartCrcSlice8Reflected()相同
+ */
+template <uint16_t Poly, bool Copy>
+uint16_t uartCrcSlice8Normal16(uint16_t crc, const char* data, size_t length, char* out) {
+    const uint16_t (*t)[256] = UartCrcTable<uint16_t, Poly, false>::get().t;
+    const unsigned char* p   = reinterpret_cast<const unsigned char*>(data);
+
+    while (length >= 8) {
+        if (Copy) {
+            std::memcpy(out, p, 8);
+            out += 8;
+        }
+
+        // 16位的CRC寄存器只影响前两个字节
+        crc = t[7][p[0] ^ (crc >> 8)] ^ t[6][p[1] ^ (crc & 0xFF)]
+            ^ t[5][p[2]] ^ t[4][p[3]] ^ t[3][p[4]] ^ t[2][p[5]] ^ t[1][p[6]] ^ t[0][p[7]];
+
+        p      += 8;
+        length -= 8;
+    } /* while (length >= 8) { */
+
+    while (length-- > 0) {
+        unsigned char byte = *p++;
+
+        if (Copy) {
+            *out++ = static_cast<char>(byte);
+        }
+
+        crc = static_cast<uint16_t>((crc << 8) ^ t[0][(crc >> 8) ^ byte]);
+    }
+
+    return crc;
+} /* uint16_t uartCrcSlice8Normal16(...) { */
+
+#if defined(UART_CRC_PCLMUL)
+/**
+ * @brief CRC-32的PCLMULQDQ折叠实现（Intel白皮书“Fast CRC Computation for Generic Polynomials Using
+ *        PCLMULQDQ Instruction”，常数与Chromium zlib的crc32_simd.c相同）
+ * @param crc    : CRC寄存器的当前值（不含输出异或）
+ * @param length : 不小于64且为16的倍数
+ * @note 4路并行折叠64字节，再折叠到128位，最后用Barrett约简得到32位结果
+ */
+template <bool Copy>
+__attribute__((target("pclmul,sse4.1")))
+uint32_t uartCrc32Pclmul(uint32_t crc, const char* data, size_t length, char* out) {
+    alignas(16) static const uint64_t k1k2[] = {0x0154442bd4ULL, 0x01c6e41596ULL};
+    alignas(16) static const uint64_t k3k4[] = {0x01751997d0ULL, 0x00ccaa009eULL};
+    alignas(16) static const uint64_t k5k0[] = {0x0163cd6124ULL, 0x0000000000ULL};
+    alignas(16) static const uint64_t poly[] = {0x01db710641ULL, 0x01f7011641ULL};
+
+    const __m128i* p = reinterpret_cast<const __m128i*>(data);
+    __m128i* dest    = reinterpret_cast<__m128i*>(out);
+
+    __m128i x0, x1, x2, x3, x4, x5, x6, x7, x8, y5, y6, y7, y8;
+
+    x1 = _mm_loadu_si128(p + 0);
+    x2 = _mm_loadu_si128(p + 1);
+    x3 = _mm_loadu_si128(p + 2);
+    x4 = _mm_loadu_si128(p + 3);
+
+    if (Copy) {
+        _mm_storeu_si128(dest + 0, x1);
+        _mm_storeu_si128(dest + 1, x2);
+        _mm_storeu_si128(dest + 2, x3);
+        _mm_storeu_si128(dest + 3, x4);
+        dest += 4;
+    }
+
+    x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128(static_cast<int>(crc)));
+    x0 = _mm_load_si128(reinterpret_cast<const __m128i*>(k1k2));
+
+    p      += 4;
+    length -= 64;
+
+    // 4路并行折叠
+    while (length >= 64) {
+        x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x6 = _mm_clmulepi64_si128(x2, x0, 0x00);
+        x7 = _mm_clmulepi64_si128(x3, x0, 0x00);
+        x8 = _mm_clmulepi64_si128(x4, x0, 0x00);
+
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x2 = _mm_clmulepi64_si128(x2, x0, 0x11);
+        x3 = _mm_clmulepi64_si128(x3, x0, 0x11);
+        x4 = _mm_clmulepi64_si128(x4, x0, 0x11);
+
+        y5 = _mm_loadu_si128(p + 0);
+        y6 = _mm_loadu_si128(p + 1);
+        y7 = _mm_loadu_si128(p + 2);
+        y8 = _mm_loadu_si128(p + 3);
+
+        if (Copy) {
+            _mm_storeu_si128(dest + 0, y5);
+            _mm_storeu_si128(dest + 1, y6);
+            _mm_storeu_si128(dest + 2, y7);
+            _mm_storeu_si128(dest + 3, y8);
+            dest += 4;
+        }
+
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), y5);
+        x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), y6);
+        x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), y7);
+        x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), y8);
+
+        p      += 4;
+        length -= 64;
+    } /* while (length >= 64) { */
+
+    // 折叠到128位
+    x0 = _mm_load_si128(reinterpret_cast<const __m128i*>(k3k4));
+
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+
+    // 剩余的16字节块逐块折叠
+    while (length >= 16) {
+        x2 = _mm_loadu_si128(p);
+
+        if (Copy) {
+            _mm_storeu_si128(dest, x2);
+            ++dest;
+        }
+
+        x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+
+        ++p;
+        length -= 16;
+    } /* while (length >= 16) { */
+
+    // 128位折叠到64位
+    x2 = _mm_clmulepi64_si128(x1, x0, 0x10);
+    x3 = _mm_setr_epi32(~0, 0, ~0, 0);
+    x1 = _mm_srli_si128(x1, 8);
+    x1 = _mm_xor_si128(x1, x2);
+
+    x0 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(k5k0));
+
+    x2 = _mm_srli_si128(x1, 4);
+    x1 = _mm_and_si128(x1, x3);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    // Barrett约简到32位
+    x0 = _mm_load_si128(reinterpret_cast<const __m128i*>(poly));
+
+    x2 = _mm_and_si128(x1, x3);
+    x2 = _mm_clmulepi64_si128(x2, x0, 0x10);
+    x2 = _mm_and_si128(x2, x3);
+    x2 = _mm_clmulepi64_si128(x2, x0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    return static_cast<uint32_t>(_mm_extract_epi32(x1, 1));
+} /* uint32_t uartCrc32Pclmul(...) { */
+#endif /* UART_CRC_PCLMUL */
+
+#if defined(UART_CRC_ARMV8)
+/**
+ * @brief CRC-32的ARMv8 CRC32指令实现，每条指令处理8字节
+ * @param crc : CRC寄存器的当前值（不含输出异或）
+ */
+template <bool Copy>
+UART_CRC_TARGET_ARMV8
+uint32_t uartCrc32Armv8(uint32_t crc, const char* data, size_t length, char* out) {
+    while (length >= 8) {
+        uint64_t word;
+        std::memcpy(&word, data, 8);
+
+        if (Copy) {
+            std::memcpy(out, &word, 8);
+            out += 8;
+        }
+
+        crc     = __crc32d(crc, word);
+        data   += 8;
+        length -= 8;
+    } /* while (length >= 8) { */
+
+    while (length-- > 0) {
+        uint8_t byte = static_cast<uint8_t>(*data++);
+
+        if (Copy) {
+            *out++ = static_cast<char>(byte);
+        }
+
+        crc = __crc32b(crc, byte);
+    }
+
+    return crc;
+} /* uint32_t uartCrc32Armv8(...) { */
+#endif /* UART_CRC_ARMV8 */
+
+/**
+ * @brief CRC-32寄存器的更新，按accel选择实现，CPU不支持时退回查表
+ * @param crc : CRC寄存器的当前值（不含输出异或）
+ */
+template <bool Copy>
+uint32_t uartCrc32Register(uint32_t crc, const char* data, size_t length, char* out, UartCrcAccel accel) {
+#if defined(UART_CRC_PCLMUL)
+    if (accel == UartCrcAccel::Pclmul && length >= 64 && uartCrcAccel() == UartCrcAccel::Pclmul) {
+        size_t chunk = length & ~static_cast<size_t>(15);
+        crc = uartCrc32Pclmul<Copy>(crc, data, chunk, out);
+
+        data   += chunk;
+        out    += Copy ? chunk : 0;
+        length -= chunk;
+    }
+#elif defined(UART_CRC_ARMV8)
+    if (accel == UartCrcAccel::Armv8 && uartCrcAccel() == UartCrcAccel::Armv8) {
+        return uartCrc32Armv8<Copy>(crc, data, length, out);
+    }
+#endif
+    (void)accel;
+    return uartCrcSlice8Reflected<uint32_t, 0xEDB88320, Copy>(crc, data, length, out);
+} /* uint32_t uartCrc32Register(...) { */
+
+/**
+ * @brief CRC-16/CCITT-FALSE：多项式0x1021，初值0xFFFF，不反射，无输出异或（"123456789"的结果为0x29B1）
+ * @note update()可以分段调用：update(update(kInit, a), b) == compute(a + b)
+ */
+struct UartCrc16Ccitt {
+    typedef uint16_t Value;
+    static const uint16_t kInit = 0xFFFF;
+
+    static uint16_t update(uint16_t crc, const char* data, size_t length) {
+        return uartCrcSlice8Normal16<0x1021, false>(crc, data, length, nullptr);
+    }
+
+    /**
+     * @brief 把数据拷贝到out，并在同一遍内更新CRC
+     */
+    static uint16_t copy(uint16_t crc, const char* data, size_t length, char* out) {
+        return uartCrcSlice8Normal16<0x1021, true>(crc, data, length, out);
+    }
+
+    static uint16_t compute(const char* data, size_t length) {
+        return update(kInit, data, length);
+    }
+};
+
+/**
+ * @brief CRC-16/MODBUS：多项式0x8005（反射为0xA001），初值0xFFFF，反射，无输出异或（"123456789"的结果为0x4B37）
+ * @note 结果按低字节在前追加到帧尾；用法与UartCrc16Ccitt相同
+ */
+struct UartCrc16Modbus {
+    typedef uint16_t Value;
+    static const uint16_t kInit = 0xFFFF;
+
+    static uint16_t update(uint16_t crc, const char* data, size_t length) {
+        return uartCrcSlice8Reflected<uint16_t, 0xA001, false>(crc, data, length, nullptr);
+    }
+
+    static uint16_t copy(uint16_t crc, const char* data, size_t length, char* out) {
+        return uartCrcSlice8Reflected<uint16_t, 0xA001, true>(crc, data, length, out);
+    }
+
+    static uint16_t compute(const char* data, size_t length) {
+        return update(kInit, data, length);
+    }
+};
+
+/**
+ * @brief CRC-32（ISO-HDLC，与zlib相同）：多项式0x04C11DB7（反射为0xEDB88320），初值与输出异或均为0xFFFFFFFF
+ *        （"123456789"的结果为0xCBF43926）
+ * @note 与zlib的crc32()一样以0为初值分段调用；x86上≥64字节的部分使用PCLMULQDQ，AArch64上使用CRC32指令，
+ *       其余情况使用slice-by-8查表，运行时按CPU选择
+ */
+struct UartCrc32 {
+    typedef uint32_t Value;
+    static const uint32_t kInit = 0;
+
+    static uint32_t update(uint32_t crc, const char* data, size_t length, UartCrcAccel accel = uartCrcAccel()) {
+        return ~uartCrc32Register<false>(~crc, data, length, nullptr, accel);
+    }
+
+    static uint32_t copy(uint32_t crc, const char* data, size_t length, char* out,
+                         UartCrcAccel accel = uartCrcAccel()) {
+        return ~uartCrc32Register<true>(~crc, data, length, out, accel);
+    }
+
+    static uint32_t compute(const char* data, size_t length) {
+        return update(kInit, data, length);
+    }
+};
+
+/**
+ * @brief 从接收环形缓冲区拷贝并丢弃数据，拷贝的同时计算CRC
+ * @tparam Crc  : UartCrc16Ccitt、UartCrc16Modbus或UartCrc32
+ * @param ring   : 接收环形缓冲区（UartRxRing），仅消费者调用
+ * @param out    : 输出缓冲区
+ * @param length : 最多拷贝的字节数
+ * @param crc    : 输入为CRC的当前值，输出为加入拷贝数据后的值
+ * @return 实际拷贝的字节数
+ * @note 与UartRxRing::read()相同，数据在环尾回绕时分两段处理，每段只读一遍
+ */
+template <typename Crc, typename Ring>
+size_t uartCrcRead(Ring& ring, char* out, size_t length, typename Crc::Value& crc) {
+    size_t copied = 0;
+
+    while (copied < length) {
+        UartSpan span = ring.peek();
+
+        if (span.size == 0) {
+            break;
+        }
+
+        size_t count = length - copied < span.size ? length - copied : span.size;
+        crc = Crc::copy(crc, span.data, count, out + copied);
+        ring.consume(count);
+        copied += count;
+    } /* while (copied < length) { */
+
+    return copied;
+} /* size_t uartCrcRead(...) { */
+
+#endif /* __UART_CRC_HPP */
@@ -0,0 +1,315 @@
+#ifndef __UART_FRAME_HPP
+#define __UART_FRAME_HPP
+
+// 标准库
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include "uart.hpp"
+#include "uart_simd.hpp"
+#include "uart_transport.hpp"
+
+/**
+ * @brief 以分隔符结尾的帧的切分器，不依赖数据来源
+ * @note 数据通过prepare()/commit()直接写入内部缓冲区，next()用SIMD从上次扫描停止处继续查找分隔符，
+ *       跨两次读取的帧不会被重复扫描。返回的帧指向内部缓冲区，不含分隔符，在下一次prepare()之前有效
+ */
+class UartFrameScanner {
+public:
+    /**
+     * @brief 构造函数
+     * @param delimiter : 帧分隔符，如'\n'、0x7E（HDLC）、0x00（COBS）
+     * @param capacity  : 缓冲区大小，即最长的帧（含分隔符）的长度，默认为65536
+     * @param skipEmpty : 是否丢弃空帧（连续的分隔符），默认为true
+     * @param level     : 查找分隔符使用的指令集，默认为当前CPU支持的最佳指令集
+     */
+    explicit UartFrameScanner(char delimiter, size_t capacity = 65536, bool skipEmpty = true,
+                              UartSimd level = uartSimdLevel())
+        : _buffer(capacity)
+        , _begin(0)
+        , _scanned(0)
+        , _end(0)
+        , _level(level)
+        , _delimiter(delimiter)
+        , _skipEmpty(skipEmpty) {
+            if (capacity == 0) {
+                throw std::invalid_argument("Invalid frame buffer capacity.");
+            }
+        }
+
+    /**
+     * @brief 为下一次写入腾出空间，之前返回的帧随即失效
+     * @param space : 输出，可写入的字节数，不小于1
+     * @return 写入的起始地址
+     * @note 缓冲区已满且没有完整的帧可丢弃时抛出std::length_error
+     */
+    char* prepare(size_t& space) {
+        if (_begin == _end) {
+            _begin   = 0;
+            _scanned = 0;
+            _end     = 0;
+        } else if (_end == _buffer.size()) {
+            if (_begin == 0) {
+                throw std::length_error("Frame exceeds the buffer capacity.");
+            }
+
+            std::memmove(_buffer.data(), _buffer.data() + _begin, _end - _begin);
+            _scanned -= _begin;
+            _end     -= _begin;
+            _begin    = 0;
+        }
+
+        space = _buffer.size() - _end;
+        return _buffer.data() + _end;
+    } /* char* prepare(size_t& space) { */
+
+    /**
+     * @brief 确认已写入prepare()返回的空间的字节数
+     */
+    void commit(size_t length) {
+        _end += length;
+    }
+
+    /**
+     * @brief 从外部内存拷入数据，用于回放抓包等非串口来源
+     * @return 实际拷入的字节数，缓冲区满时可能小于length
+     */
+    size_t feed(const char* data, size_t length) {
+        size_t space;
+        char* dest = prepare(space);
+        size_t count = length < space ? length : space;
+
+        std::memcpy(dest, data, count);
+        commit(count);
+        return count;
+    }
+
+    /**
+     * @brief 取出下一帧
+     * @param frame : 输出，帧的内容（不含分隔符）
+     * @return 缓冲区中有完整的帧返回true，否则返回false
+     */
+    bool next(UartSpan& frame) {
+        char* data;
+        size_t size;
+
+        if (!next(data, size)) {
+            return false;
+        }
+
+        frame.data = data;
+        frame.size = size;
+        return true;
+    }
+
+    /**
+     * @brief 取出下一帧，调用者可以就地修改帧的内容（如COBS、HDLC解码）
+     * @param data : 输出，帧的起始地址
+     * @param size : 输出，帧的长度（不含分隔符）
+     * @return 与next(UartSpan&)相同
+     */
+    bool next(char*& data, size_t& size) {
+        char* base = _buffer.data();
+
+        for (;;) {
+            const char* found = uartFindByte(base + _scanned, base + _end, _delimiter, _level);
+
+            if (found == base + _end) {
+                _scanned = _end;
+                return false;
+            }
+
+            size_t stop  = found - base;
+            size_t start = _begin;
+            _begin   = stop + 1;
+            _scanned = _begin;
+
+            if (stop != start || !_skipEmpty) {
+                data = base + start;
+                size = stop - start;
+                return true;
+            }
+        } /* for (;;) { */
+    } /* bool next(char*& data, size_t& size) { */
+
+    /**
+     * @brief 缓冲区中尚未组成完整帧的数据
+     */
+    UartSpan pending() const {
+        UartSpan span = {_buffer.data() + _begin, _end - _begin};
+        return span;
+    }
+
+    /**
+     * @brief 丢弃缓冲区中的全部数据，用于失步后重新同步
+     */
+    void reset() {
+        _begin   = 0;
+        _scanned = 0;
+        _end     = 0;
+    }
+
+private:
+    std::vector<char> _buffer; // 接收缓冲区
+    size_t _begin;             // 下一帧的起始位置
+    size_t _scanned;           // 已扫描过的位置
+    size_t _end;               // 数据的结束位置
+    UartSimd _level;           // 查找分隔符使用的指令集
+    char _delimiter;           // 帧分隔符
+    bool _skipEmpty;           // 是否丢弃空帧
+};
+
+/**
+ * @brief 按帧读取器
+ * @note 每次读取都直接写入UartFrameScanner的缓冲区，返回的帧不做拷贝，
+ *       在下一次调用next()/nextUntil()/drain()之前有效。
+ *       Transport为const Uart（即UartFrameReader）或UartTransport的派生类，通过UartIo访问。
+ *       串口应使用默认的ReadPolicy::Any（非阻塞）读取策略
+ */
+template <typename Transport>
+class UartBasicFrameReader {
+public:
+    /**
+     * @brief 构造函数
+     * @param transport : 数据来源，例如已打开的串口，其生命周期必须长于读取器
+     * @param delimiter : 帧分隔符
+     * @param capacity  : 缓冲区大小，即最长的帧（含分隔符）的长度，默认为65536
+     * @param skipEmpty : 是否丢弃空帧，默认为true
+     */
+    UartBasicFrameReader(Transport& transport, char delimiter, size_t capacity = 65536, bool skipEmpty = true)
+        : _transport(transport)
+        , _scanner(delimiter, capacity, skipEmpty) {}
+
+    /**
+     * @brief 取出下一帧（非阻塞）
+     * @param frame : 输出，帧的内容（不含分隔符）
+     * @return 取到完整的帧返回true；暂无完整的帧返回false
+     * @note 缓冲区已满仍没有分隔符时抛出std::length_error，读取出错时抛出std::runtime_error
+     */
+    bool next(UartSpan& frame) {
+        return _scanner.next(frame) || (fill() && _scanner.next(frame));
+    }
+
+    /**
+     * @brief 取出下一帧（非阻塞），调用者可以就地修改帧的内容
+     * @return 与next(UartSpan&)相同
+     */
+    bool next(char*& data, size_t& size) {
+        return _scanner.next(data, size) || (fill() && _scanner.next(data, size));
+    }
+
+    /**
+     * @brief 在截止时间前取出下一帧
+     * @param frame    : 输出，帧的内容（不含分隔符）
+     * @param deadline : 截止时间，Uart::Clock::time_point::max()表示一直等待
+     * @return 取到完整的帧返回true；超时返回false
+     * @note 串口通过Uart::receiveFor()等待，异常与next()相同，对端关闭时抛出std::runtime_error
+     */
+    bool nextUntil(UartSpan& frame, Uart::Clock::time_point deadline) {
+        char* data;
+        size_t size;
+
+        if (!nextUntil(data, size, deadline)) {
+            return false;
+        }
+
+        frame.data = data;
+        frame.size = size;
+        return true;
+    }
+
+    /**
+     * @brief 在截止时间前取出下一帧，调用者可以就地修改帧的内容
+     * @return 与nextUntil(UartSpan&, ...)相同
+     */
+    bool nextUntil(char*& data, size_t& size, Uart::Clock::time_point deadline) {
+        while (!_scanner.next(data, size)) {
+            size_t space;
+            char* dest = _scanner.prepare(space);
+            UartProgress progress = UartIo<Transport>::readBefore(_transport, dest, space, deadline);
+            _scanner.commit(progress.bytes);
+
+            if (progress.error == std::errc::timed_out) {
+                return _scanner.next(data, size);
+            }
+
+            if (progress.error) {
+                throw std::runtime_error("Error in receiving data.");
+            }
+        } /* while (!_scanner.next(data, size)) { */
+
+        return true;
+    } /* bool nextUntil(char*& data, size_t& size, Uart::Clock::time_point deadline) { */
+
+    /**
+     * @brief 读取一次，并把缓冲区中所有完整的帧依次交给handler
+     * @param handler : 形如void(UartSpan)的可调用对象，帧在handler返回后失效
+     * @return 交出的帧数
+     * @note 高吞吐场景下比逐帧调用next()少一半的读取调用；异常与next()相同
+     */
+    template <typename Handler>
+    size_t drain(Handler&& handler) {
+        UartSpan frame;
+        size_t count = 0;
+
+        while (_scanner.next(frame)) {
+            handler(frame);
+            ++count;
+        }
+
+        if (!fill()) {
+            return count;
+        }
+
+        while (_scanner.next(frame)) {
+            handler(frame);
+            ++count;
+        }
+
+        return count;
+    } /* size_t drain(Handler&& handler) { */
+
+    /**
+     * @brief 缓冲区中尚未组成完整帧的数据
+     */
+    UartSpan pending() const {
+        return _scanner.pending();
+    }
+
+    /**
+     * @brief 丢弃缓冲区中的全部数据
+     */
+    void reset() {
+        _scanner.reset();
+    }
+
+private:
+    /**
+     * @brief 非阻塞地读取一次
+     * @return 读到数据返回true
+     */
+    bool fill() {
+        size_t space;
+        char* dest = _scanner.prepare(space);
+        UartResult result = UartIo<Transport>::read(_transport, dest, space);
+
+        if (!result.has_value()) {
+            if (result.error() == std::errc::operation_would_block) {
+                return false;
+            }
+            throw std::runtime_error("Error in receiving data.");
+        }
+
+        _scanner.commit(*result);
+        return *result > 0;
+    } /* bool fill() { */
+
+    Transport& _transport;     // 数据来源
+    UartFrameScanner _scanner; // 帧切分
+};
+
+typedef UartBasicFrameReader<const Uart> UartFrameReader;
+
+#endif /* __UART_FRAME_HPP */
@@ -0,0 +1,85 @@
+#ifndef __UART_LINE_HPP
+#define __UART_LINE_HPP
+
+#if __cplusplus < 201703L
+#error "uart_line.hpp requires C++17."
+#endif
+
+// 标准库
+#include <string_view>
+
+#include "uart.hpp"
+#include "uart_frame.hpp"
+#include "uart_transport.hpp"
+
+/**
+ * @brief 文本协议的按行读取器
+ * @note 基于UartBasicFrameReader（保留空行），数据直接读入UartFrameScanner的缓冲区，
+ *       返回的行是指向该缓冲区的std::string_view，不做拷贝，在下一次调用next()/nextUntil()之前有效。
+ *       每次只扫描新读到的数据，已取走的行在缓冲区需要空间时才整体前移。
+ *       行不包含分隔符，行尾的'\r'原样保留。
+ *       Transport为const Uart（即UartLineReader）或UartTransport的派生类。
+ *       串口应使用默认的ReadPolicy::Any（非阻塞）读取策略
+ */
+template <typename Transport>
+class UartBasicLineReader {
+public:
+    /**
+     * @brief 构造函数
+     * @param transport : 数据来源，例如已打开的串口，其生命周期必须长于读取器
+     * @param capacity  : 缓冲区大小，即最长的行（含分隔符）的长度，默认为4096
+     * @param delimiter : 行分隔符，默认为'\n'
+     */
+    explicit UartBasicLineReader(Transport& transport, size_t capacity = 4096, char delimiter = '\n')
+        : _reader(transport, delimiter, capacity, false) {}
+
+    /**
+     * @brief 取出下一行（非阻塞）
+     * @param line : 输出，下一行的内容
+     * @return 取到完整的一行返回true；暂无完整的行返回false
+     * @note 缓冲区已满仍没有分隔符时抛出std::length_error，读取出错时抛出std::runtime_error
+     */
+    bool next(std::string_view& line) {
+        UartSpan frame;
+
+        if (!_reader.next(frame)) {
+            return false;
+        }
+
+        line = std::string_view(frame.data, frame.size);
+        return true;
+    }
+
+    /**
+     * @brief 在截止时间前取出下一行
+     * @param line     : 输出，下一行的内容
+     * @param deadline : 截止时间，Uart::Clock::time_point::max()表示一直等待
+     * @return 取到完整的一行返回true；超时返回false
+     * @note 串口通过Uart::receiveFor()等待，不忙等也不休眠；异常与next()相同，对端关闭时抛出std::runtime_error
+     */
+    bool nextUntil(std::string_view& line, Uart::Clock::time_point deadline) {
+        UartSpan frame;
+
+        if (!_reader.nextUntil(frame, deadline)) {
+            return false;
+        }
+
+        line = std::string_view(frame.data, frame.size);
+        return true;
+    }
+
+    /**
+     * @brief 缓冲区中尚未组成完整行的数据
+     */
+    std::string_view pending() const {
+        UartSpan span = _reader.pending();
+        return std::string_view(span.data, span.size);
+    }
+
+private:
+    UartBasicFrameReader<Transport> _reader; // 按分隔符切分，保留空行
+};
+
+typedef UartBasicLineReader<const Uart> UartLineReader;
+
+#endif /* __UART_LINE_HPP */
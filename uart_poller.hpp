@@ -0,0 +1,199 @@
+#ifndef __UART_POLLER_HPP
+#define __UART_POLLER_HPP
+
+// 标准库
+#include <chrono>
+#include <stdexcept>
+
+// 第三方库
+#include <pthread.h>
+#include <sched.h>
+#include <poll.h>
+#include <errno.h>
+
+#include "uart.hpp"
+
+/**
+ * @brief 低延迟接收器，支持阻塞、忙轮询以及先自旋后阻塞三种等待方式
+ * @note 忙轮询在非阻塞的串口上反复调用read()，数据到达后无需经过调度器唤醒，
+ *       以占满一个CPU核心为代价换取最低的延迟抖动，通常配合pinCurrentThread()使用。
+ *       先自旋后阻塞在自旋时间内等到数据时与忙轮询相同，否则退化为poll()阻塞等待。
+ *       串口应使用默认的ReadPolicy::Any（非阻塞）读取策略，可配合Uart::setLowLatency()使用。
+ */
+class UartPoller {
+public:
+    /**
+     * @brief 等待方式
+     */
+    enum class Mode {
+        Block,    // poll()阻塞等待
+        BusyPoll, // 忙轮询，直到数据到达或超时
+        Hybrid    // 先忙轮询spinUs微秒，仍无数据则poll()阻塞等待
+    };
+
+    /**
+     * @brief 统计信息
+     */
+    struct Stats {
+        uint64_t spinHits; // 自旋期间等到数据的次数
+        uint64_t blocks;   // 进入poll()阻塞等待的次数
+        uint64_t timeouts; // 超时次数
+    };
+
+    /**
+     * @brief 构造函数
+     * @param uart   : 已打开的串口，其生命周期必须长于UartPoller
+     * @param mode   : 等待方式，默认为先自旋后阻塞
+     * @param spinUs : Hybrid方式下的自旋时间（微秒），默认为50
+     */
+    explicit UartPoller(const Uart& uart, Mode mode = Mode::Hybrid, unsigned spinUs = 50)
+        : _uart(uart)
+        , _mode(mode)
+        , _spinUs(spinUs) {
+            _stats.spinHits = 0;
+            _stats.blocks   = 0;
+            _stats.timeouts = 0;
+        }
+
+    /**
+     * @brief 将调用线程绑定到指定的CPU核心
+     * @param cpu : CPU编号
+     * @note 忙轮询线程独占一个核心，可避免被迁移带来的缓存失效与延迟抖动
+     */
+    static void pinCurrentThread(int cpu) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+
+        if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0) {
+            throw std::runtime_error("Error in setting CPU affinity.");
+        }
+    }
+
+    /**
+     * @brief 接收数据
+     * @param buffer    : 数据缓冲区基地址
+     * @param length    : 接收的数据的最大长度（单位：字节）
+     * @param timeoutMs : 最长等待时间（毫秒），-1表示一直等待，默认为-1
+     * @return 接收的数据长度，超时或对端关闭时返回0
+     * @note 不会在数据末尾写入'\0'
+     */
+    size_t receive(char* buffer, size_t length, int timeoutMs = -1) {
+        typedef std::chrono::steady_clock Clock;
+
+        if (buffer == nullptr) {
+            throw std::invalid_argument("Buffer cannot be nullptr.");
+        }
+
+        Clock::time_point start = Clock::now();
+        Clock::time_point deadline = timeoutMs < 0 ? Clock::time_point::max()
+                                                   : start + std::chrono::milliseconds(timeoutMs);
+
+        if (_mode != Mode::Block) {
+            Clock::time_point spinEnd = _mode == Mode::BusyPoll ? deadline
+                                                                : start + std::chrono::microseconds(_spinUs);
+            if (spinEnd > deadline) {
+                spinEnd = deadline;
+            }
+
+            for (;;) {
+                size_t n;
+
+                if (tryRead(buffer, length, n)) {
+                    _stats.spinHits += 1;
+                    return n;
+                }
+
+                if (Clock::now() >= spinEnd) {
+                    break;
+                }
+
+                cpuRelax();
+            }
+
+            if (_mode == Mode::BusyPoll) {
+                _stats.timeouts += 1;
+                return 0;
+            }
+        } /* if (_mode != Mode::Block) { */
+
+        for (;;) {
+            int waitMs = -1;
+
+            if (timeoutMs >= 0) {
+                Clock::duration left = deadline - Clock::now();
+                waitMs = left.count() > 0
+                       ? static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(left).count()) + 1
+                       : 0;
+            }
+
+            struct pollfd pfd;
+            pfd.fd     = _uart.getFd();
+            pfd.events = POLLIN;
+
+            _stats.blocks += 1;
+
+            int ret = ::poll(&pfd, 1, waitMs);
+
+            if (ret == -1 && errno != EINTR) {
+                throw std::runtime_error("Error in waiting for data.");
+            }
+
+            size_t n;
+
+            if (ret > 0 && tryRead(buffer, length, n)) {
+                return n;
+            }
+
+            if (timeoutMs >= 0 && Clock::now() >= deadline) {
+                _stats.timeouts += 1;
+                return 0;
+            }
+        } /* for (;;) { */
+    } /* size_t receive(char* buffer, size_t length, int timeoutMs = -1) { */
+
+    /**
+     * @brief 获取统计信息
+     */
+    const Stats& getStats() const {
+        return _stats;
+    }
+
+private:
+    /**
+     * @brief 尝试读取一次
+     * @return true表示read()有结果（读到数据，或返回0表示对端已关闭），false表示暂无数据
+     */
+    bool tryRead(char* buffer, size_t length, size_t& n) const {
+        UartResult result = _uart.tryReceive(buffer, length);
+
+        if (result.has_value()) {
+            n = *result;
+            return true;
+        }
+
+        if (result.error() != std::errc::operation_would_block) {
+            throw std::runtime_error("Error in receiving data.");
+        }
+
+        return false;
+    }
+
+    /**
+     * @brief 自旋等待提示，降低忙轮询对同核超线程与功耗的影响
+     */
+    static void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+        __asm__ __volatile__("yield");
+#endif
+    }
+
+    const Uart& _uart;  // 数据来源
+    Mode _mode;         // 等待方式
+    unsigned _spinUs;   // Hybrid方式下的自旋时间
+    Stats _stats;       // 统计信息
+};
+
+#endif /* __UART_POLLER_HPP */
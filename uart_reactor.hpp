@@ -0,0 +1,259 @@
+#ifndef __UART_REACTOR_HPP
+#define __UART_REACTOR_HPP
+
+// 标准库
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+// 第三方库
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <errno.h>
+
+#include "uart.hpp"
+
+/**
+ * @brief 基于epoll的多串口事件分发器
+ * @note 所有注册的串口共用一个epoll实例，单线程调用poll()/run()即可服务成百上千个串口。
+ *       回调在调用poll()的线程中执行，因此回调内不应阻塞。
+ */
+class UartReactor {
+public:
+    /**
+     * @brief 事件类型，可按位组合
+     */
+    enum Event : uint32_t {
+        Readable = EPOLLIN,              // 可读
+        Writable = EPOLLOUT,             // 可写
+        Error    = EPOLLERR | EPOLLHUP,  // 出错或对端挂断（总是会被上报）
+        Edge     = EPOLLET               // 边沿触发，默认为水平触发
+    };
+
+    /**
+     * @brief 事件回调
+     * @param uart   : 产生事件的串口
+     * @param events : 实际发生的事件（Event的按位组合）
+     */
+    using Callback = std::function<void(Uart& uart, uint32_t events)>;
+
+    /**
+     * @brief 构造函数
+     * @param maxEvents : 单次epoll_wait最多返回的事件数，默认为256
+     */
+    explicit UartReactor(int maxEvents = 256)
+        : _epfd(-1)
+        , _wakeFd(-1)
+        , _running(false)
+        , _events(maxEvents > 0 ? maxEvents : 1) {
+
+            _epfd = ::epoll_create1(EPOLL_CLOEXEC);
+
+            if (_epfd == -1) {
+                throw std::runtime_error("Error in creating epoll instance.");
+            }
+
+            _wakeFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+            if (_wakeFd == -1) {
+                ::close(_epfd);
+                throw std::runtime_error("Error in creating wakeup eventfd.");
+            }
+
+            struct epoll_event ev = {};
+            ev.events  = EPOLLIN;
+            ev.data.fd = _wakeFd;
+
+            if (::epoll_ctl(_epfd, EPOLL_CTL_ADD, _wakeFd, &ev) == -1) {
+                ::close(_wakeFd);
+                ::close(_epfd);
+                throw std::runtime_error("Error in registering wakeup eventfd.");
+            }
+        } /* explicit UartReactor(int maxEvents = 256) { */
+
+    ~UartReactor() {
+        ::close(_wakeFd);
+        ::close(_epfd);
+    }
+
+    UartReactor(const UartReactor&)            = delete;
+    UartReactor& operator=(const UartReactor&) = delete;
+
+    /**
+     * @brief 注册串口
+     * @param uart     : 已打开的串口，其生命周期必须长于注册期
+     * @param events   : 关注的事件（Event的按位组合）
+     * @param callback : 事件回调
+     */
+    void add(Uart& uart, uint32_t events, Callback callback) {
+        int fd = uart.getFd();
+
+        if (fd < 0) {
+            throw std::invalid_argument("UART port has no valid file descriptor.");
+        }
+
+        if (!callback) {
+            throw std::invalid_argument("Callback cannot be empty.");
+        }
+
+        if (static_cast<size_t>(fd) >= _entries.size()) {
+            _entries.resize(fd + 1);
+        }
+
+        if (_entries[fd]) {
+            throw std::invalid_argument("UART port is already registered.");
+        }
+
+        struct epoll_event ev = {};
+        ev.events  = events;
+        ev.data.fd = fd;
+
+        if (::epoll_ctl(_epfd, EPOLL_CTL_ADD, fd, &ev) == -1) {
+            throw std::runtime_error("Error in registering UART port.");
+        }
+
+        _entries[fd].reset(new Entry{&uart, std::move(callback)});
+    } /* void add(Uart& uart, uint32_t events, Callback callback) { */
+
+    /**
+     * @brief 修改串口关注的事件
+     * @param uart   : 已注册的串口
+     * @param events : 新的关注事件，例如在有待发送数据时加上Writable
+     */
+    void modify(Uart& uart, uint32_t events) {
+        int fd = uart.getFd();
+
+        if (find(fd) == nullptr) {
+            throw std::invalid_argument("UART port is not registered.");
+        }
+
+        struct epoll_event ev = {};
+        ev.events  = events;
+        ev.data.fd = fd;
+
+        if (::epoll_ctl(_epfd, EPOLL_CTL_MOD, fd, &ev) == -1) {
+            throw std::runtime_error("Error in modifying UART port events.");
+        }
+    } /* void modify(Uart& uart, uint32_t events) { */
+
+    /**
+     * @brief 注销串口
+     * @note 可以在回调中调用（包括注销自身），必须在关闭串口之前调用
+     */
+    void remove(Uart& uart) {
+        int fd = uart.getFd();
+
+        if (find(fd) == nullptr) {
+            return;
+        }
+
+        ::epoll_ctl(_epfd, EPOLL_CTL_DEL, fd, nullptr);
+
+        // 回调可能正在执行，延迟到本轮分发结束后再销毁
+        _retired.push_back(std::move(_entries[fd]));
+    } /* void remove(Uart& uart) { */
+
+    /**
+     * @brief 等待一次事件并分发回调
+     * @param timeoutMs : 超时时间（毫秒），-1表示一直等待
+     * @return 本次分发的回调数量
+     */
+    int poll(int timeoutMs = -1) {
+        int n = ::epoll_wait(_epfd, _events.data(), static_cast<int>(_events.size()), timeoutMs);
+
+        if (n == -1) {
+            if (errno == EINTR) {
+                return 0;
+            }
+            throw std::runtime_error("Error in waiting for events.");
+        }
+
+        int dispatched = 0;
+
+        for (int i = 0; i < n; ++i) {
+            int fd = _events[i].data.fd;
+
+            if (fd == _wakeFd) {
+                uint64_t value;
+                while (::read(_wakeFd, &value, sizeof(value)) > 0) {
+                }
+                continue;
+            }
+
+            // 同一批事件中，前面的回调可能已经注销了该串口
+            Entry* entry = find(fd);
+
+            if (entry == nullptr) {
+                continue;
+            }
+
+            entry->callback(*entry->uart, _events[i].events);
+            ++dispatched;
+        } /* for (int i = 0; i < n; ++i) { */
+
+        _retired.clear();
+
+        // 事件数组被填满，说明就绪的串口较多，扩容以减少epoll_wait调用次数
+        if (static_cast<size_t>(n) == _events.size()) {
+            _events.resize(_events.size() * 2);
+        }
+
+        return dispatched;
+    } /* int poll(int timeoutMs = -1) { */
+
+    /**
+     * @brief 循环分发事件，直到stop()被调用
+     */
+    void run() {
+        _running = true;
+
+        while (_running) {
+            poll(-1);
+        }
+    }
+
+    /**
+     * @brief 停止run()循环
+     * @note 线程安全，可以在其他线程或回调中调用
+     */
+    void stop() {
+        _running = false;
+
+        uint64_t one = 1;
+        ssize_t ret = ::write(_wakeFd, &one, sizeof(one));
+        (void)ret;
+    }
+
+    /**
+     * @brief 获取epoll实例的文件描述符，便于嵌套到其他事件循环中
+     */
+    int getFd() const {
+        return _epfd;
+    }
+
+private:
+    struct Entry {
+        Uart* uart;
+        Callback callback;
+    };
+
+    Entry* find(int fd) const {
+        if (fd < 0 || static_cast<size_t>(fd) >= _entries.size()) {
+            return nullptr;
+        }
+
+        return _entries[fd].get();
+    }
+
+    int _epfd;                                   // epoll实例
+    int _wakeFd;                                 // 用于唤醒epoll_wait的eventfd
+    std::atomic<bool> _running;                  // run()循环标志
+    std::vector<struct epoll_event> _events;     // epoll_wait的输出缓冲区
+    std::vector<std::unique_ptr<Entry>> _entries; // 以fd为下标的注册表
+    std::vector<std::unique_ptr<Entry>> _retired; // 本轮分发中被注销的条目
+};
+
+#endif /* __UART_REACTOR_HPP */
@@ -0,0 +1,413 @@
+#ifndef __UART_REGISTRY_HPP
+#define __UART_REGISTRY_HPP
+
+// 标准库
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// 第三方库
+#include <unistd.h>
+#include <errno.h>
+
+#include "uart.hpp"
+
+/**
+ * @brief 串口句柄，由PortRegistry分配
+ * @note 串口移除后槽位的代数递增，旧句柄随之失效，不会误指向复用该槽位的新串口
+ */
+struct PortHandle {
+    uint32_t index;      // 槽位编号
+    uint32_t generation; // 槽位代数
+
+    bool operator==(const PortHandle& other) const {
+        return index == other.index && generation == other.generation;
+    }
+
+    bool operator!=(const PortHandle& other) const {
+        return !(*this == other);
+    }
+};
+
+/**
+ * @brief 大量串口的集中管理
+ * @note 巡检与收发频繁访问的状态（文件描述符、打开标志、计数器、截止时间）按结构数组分别连续存放，
+ *       termios与设备路径等冷数据留在Uart对象中单独存放，遍历数万个串口时只触及需要的那几列。
+ *       各数组保持紧密排列，移除时用末尾的串口填补空位，句柄经槽位表间接映射，因此不受移动影响。
+ *       非线程安全
+ */
+class PortRegistry {
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    /**
+     * @brief 单个串口的统计信息
+     */
+    struct Stats {
+        uint64_t rxBytes; // 接收的字节数
+        uint64_t txBytes; // 发送的字节数
+        uint64_t errors;  // 收发失败次数（EAGAIN除外）
+        uint64_t timeouts; // 截止时间到期次数
+    };
+
+    /**
+     * @brief 预留空间
+     * @param count : 预计管理的串口数
+     */
+    void reserve(size_t count) {
+        _slots.reserve(count);
+        _owner.reserve(count);
+        _fd.reserve(count);
+        _open.reserve(count);
+        _deadline.reserve(count);
+        _rxBytes.reserve(count);
+        _txBytes.reserve(count);
+        _errors.reserve(count);
+        _timeouts.reserve(count);
+        _ports.reserve(count);
+    }
+
+    /**
+     * @brief 接管一个串口
+     * @param uart : 串口，移动进注册表，由注册表负责关闭
+     * @return 句柄
+     */
+    PortHandle add(Uart&& uart) {
+        uint32_t index;
+
+        if (_free.empty()) {
+            if (_slots.size() == std::numeric_limits<uint32_t>::max()) {
+                throw std::length_error("Too many ports.");
+            }
+
+            index = static_cast<uint32_t>(_slots.size());
+            _slots.push_back(Slot());
+            _slots[index].generation = 0;
+        } else {
+            index = _free.back();
+            _free.pop_back();
+        }
+
+        _slots[index].dense = static_cast<uint32_t>(_fd.size());
+
+        _owner.push_back(index);
+        _fd.push_back(uart.getFd());
+        _open.push_back(uart.isOpen());
+        _deadline.push_back(noDeadline());
+        _rxBytes.push_back(0);
+        _txBytes.push_back(0);
+        _errors.push_back(0);
+        _timeouts.push_back(0);
+        _ports.push_back(std::move(uart));
+
+        PortHandle handle;
+        handle.index      = index;
+        handle.generation = _slots[index].generation;
+        return handle;
+    } /* PortHandle add(Uart&& uart) { */
+
+    /**
+     * @brief 移除并关闭串口
+     * @return 句柄有效返回true，否则返回false
+     */
+    bool remove(PortHandle handle) {
+        if (!valid(handle)) {
+            return false;
+        }
+
+        uint32_t dense = _slots[handle.index].dense;
+        uint32_t last  = static_cast<uint32_t>(_fd.size() - 1);
+
+        // 用末尾的串口填补空位，保持各数组紧密排列
+        if (dense != last) {
+            _owner[dense]    = _owner[last];
+            _fd[dense]       = _fd[last];
+            _open[dense]     = _open[last];
+            _deadline[dense] = _deadline[last];
+            _rxBytes[dense]  = _rxBytes[last];
+            _txBytes[dense]  = _txBytes[last];
+            _errors[dense]   = _errors[last];
+            _timeouts[dense] = _timeouts[last];
+            std::swap(_ports[dense], _ports[last]);
+            _slots[_owner[dense]].dense = dense;
+        }
+
+        _owner.pop_back();
+        _fd.pop_back();
+        _open.pop_back();
+        _deadline.pop_back();
+        _rxBytes.pop_back();
+        _txBytes.pop_back();
+        _errors.pop_back();
+        _timeouts.pop_back();
+        _ports.pop_back();
+
+        _slots[handle.index].generation += 1;
+        _free.push_back(handle.index);
+
+        return true;
+    } /* bool remove(PortHandle handle) { */
+
+    /**
+     * @brief 检查句柄是否仍然有效
+     */
+    bool valid(PortHandle handle) const {
+        return handle.index < _slots.size()
+            && _slots[handle.index].generation == handle.generation
+            && _slots[handle.index].dense < _fd.size()
+            && _owner[_slots[handle.index].dense] == handle.index;
+    }
+
+    /**
+     * @brief 获取串口对象，用于读写termios等冷数据
+     * @return 句柄无效时返回nullptr
+     * @note 通过串口对象关闭或重新打开串口后，应调用refresh()同步状态
+     */
+    Uart* find(PortHandle handle) {
+        return valid(handle) ? &_ports[_slots[handle.index].dense] : nullptr;
+    }
+
+    /**
+     * @brief 从串口对象重新同步文件描述符与打开标志
+     * @return 句柄有效返回true，否则返回false
+     */
+    bool refresh(PortHandle handle) {
+        if (!valid(handle)) {
+            return false;
+        }
+
+        uint32_t dense = _slots[handle.index].dense;
+        _fd[dense]   = _ports[dense].getFd();
+        _open[dense] = _ports[dense].isOpen();
+        return true;
+    }
+
+    /**
+     * @brief 串口数
+     */
+    size_t size() const {
+        return _fd.size();
+    }
+
+    /**
+     * @brief 发送数据，并更新计数器
+     * @return 同Uart::trySend()，句柄无效时为std::errc::bad_file_descriptor
+     * @note 只访问热数据，不触及串口对象
+     */
+    UartResult send(PortHandle handle, const char* data, size_t length) noexcept {
+        if (!valid(handle)) {
+            return Uart::errnoResult(EBADF);
+        }
+
+        uint32_t dense = _slots[handle.index].dense;
+
+        if (!_open[dense]) {
+            return Uart::errnoResult(EBADF);
+        }
+
+        ssize_t result;
+
+        do {
+            result = ::write(_fd[dense], data, length);
+        } while (result == -1 && errno == EINTR);
+
+        if (result == -1) {
+            return fail(dense, errno);
+        }
+
+        _txBytes[dense] += static_cast<uint64_t>(result);
+        return static_cast<size_t>(result);
+    } /* UartResult send(PortHandle handle, const char* data, size_t length) noexcept { */
+
+    /**
+     * @brief 接收数据，并更新计数器
+     * @return 同Uart::tryReceive()，句柄无效时为std::errc::bad_file_descriptor
+     * @note 只访问热数据，不触及串口对象；不会在数据末尾写入'\0'
+     */
+    UartResult receive(PortHandle handle, char* buffer, size_t length) noexcept {
+        if (!valid(handle)) {
+            return Uart::errnoResult(EBADF);
+        }
+
+        uint32_t dense = _slots[handle.index].dense;
+
+        if (!_open[dense]) {
+            return Uart::errnoResult(EBADF);
+        }
+
+        ssize_t result;
+
+        do {
+            result = ::read(_fd[dense], buffer, length);
+        } while (result == -1 && errno == EINTR);
+
+        if (result == -1) {
+            return fail(dense, errno);
+        }
+
+        _rxBytes[dense] += static_cast<uint64_t>(result);
+        return static_cast<size_t>(result);
+    } /* UartResult receive(PortHandle handle, char* buffer, size_t length) noexcept { */
+
+    /**
+     * @brief 设置截止时间，到期后由expire()报告
+     * @return 句柄有效返回true，否则返回false
+     */
+    bool setDeadline(PortHandle handle, Clock::time_point deadline) {
+        if (!valid(handle)) {
+            return false;
+        }
+
+        _deadline[_slots[handle.index].dense] = deadline.time_since_epoch().count();
+        return true;
+    }
+
+    /**
+     * @brief 取消截止时间
+     * @return 句柄有效返回true，否则返回false
+     */
+    bool clearDeadline(PortHandle handle) {
+        if (!valid(handle)) {
+            return false;
+        }
+
+        _deadline[_slots[handle.index].dense] = noDeadline();
+        return true;
+    }
+
+    /**
+     * @brief 报告并取消所有已到期的截止时间
+     * @param now       : 当前时间
+     * @param onTimeout : 回调，形如void(PortHandle)，可以在回调中重新设置截止时间，但不能添加或移除串口
+     * @return 到期的串口数
+     * @note 只顺序扫描截止时间一列
+     */
+    template <typename Callback>
+    size_t expire(Clock::time_point now, Callback&& onTimeout) {
+        Clock::rep limit = now.time_since_epoch().count();
+        size_t count = 0;
+
+        for (size_t i = 0; i < _deadline.size(); ++i) {
+            if (_deadline[i] > limit) {
+                continue;
+            }
+
+            _deadline[i]  = noDeadline();
+            _timeouts[i] += 1;
+            ++count;
+
+            PortHandle handle;
+            handle.index      = _owner[i];
+            handle.generation = _slots[_owner[i]].generation;
+            onTimeout(handle);
+        } /* for (size_t i = 0; i < _deadline.size(); ++i) { */
+
+        return count;
+    } /* size_t expire(Clock::time_point now, Callback&& onTimeout) { */
+
+    /**
+     * @brief 获取单个串口的统计信息
+     * @note 句柄无效时抛出std::invalid_argument
+     */
+    Stats getStats(PortHandle handle) const {
+        if (!valid(handle)) {
+            throw std::invalid_argument("Invalid port handle.");
+        }
+
+        uint32_t dense = _slots[handle.index].dense;
+
+        Stats stats;
+        stats.rxBytes  = _rxBytes[dense];
+        stats.txBytes  = _txBytes[dense];
+        stats.errors   = _errors[dense];
+        stats.timeouts = _timeouts[dense];
+        return stats;
+    }
+
+    /**
+     * @brief 汇总所有串口的统计信息
+     * @note 各计数器分别顺序扫描
+     */
+    Stats getTotals() const {
+        Stats totals = {0, 0, 0, 0};
+
+        for (size_t i = 0; i < _rxBytes.size(); ++i) {
+            totals.rxBytes += _rxBytes[i];
+        }
+
+        for (size_t i = 0; i < _txBytes.size(); ++i) {
+            totals.txBytes += _txBytes[i];
+        }
+
+        for (size_t i = 0; i < _errors.size(); ++i) {
+            totals.errors += _errors[i];
+        }
+
+        for (size_t i = 0; i < _timeouts.size(); ++i) {
+            totals.timeouts += _timeouts[i];
+        }
+
+        return totals;
+    } /* Stats getTotals() const { */
+
+    /**
+     * @brief 统计处于打开状态的串口数
+     */
+    size_t countOpen() const {
+        size_t count = 0;
+
+        for (size_t i = 0; i < _open.size(); ++i) {
+            count += _open[i];
+        }
+
+        return count;
+    }
+
+private:
+    /**
+     * @brief 未设置截止时间
+     */
+    static Clock::rep noDeadline() {
+        return std::numeric_limits<Clock::rep>::max();
+    }
+
+    /**
+     * @brief 槽位，将句柄映射到紧密数组中的位置
+     */
+    struct Slot {
+        uint32_t dense;      // 在各数组中的下标
+        uint32_t generation; // 代数
+    };
+
+    /**
+     * @brief 记录收发失败，EAGAIN不计入
+     */
+    UartResult fail(uint32_t dense, int error) noexcept {
+        if (error != EAGAIN && error != EWOULDBLOCK) {
+            _errors[dense] += 1;
+        }
+
+        return Uart::errnoResult(error);
+    }
+
+    std::vector<Slot> _slots;         // 槽位表
+    std::vector<uint32_t> _free;      // 空闲槽位
+
+    // 热数据，按列紧密存放
+    std::vector<uint32_t> _owner;     // 所属槽位
+    std::vector<int> _fd;             // 文件描述符
+    std::vector<uint8_t> _open;       // 是否已打开
+    std::vector<Clock::rep> _deadline; // 截止时间
+    std::vector<uint64_t> _rxBytes;   // 接收的字节数
+    std::vector<uint64_t> _txBytes;   // 发送的字节数
+    std::vector<uint64_t> _errors;    // 收发失败次数
+    std::vector<uint64_t> _timeouts;  // 截止时间到期次数
+
+    // 冷数据
+    std::vector<Uart> _ports;         // 串口对象（termios、设备路径等）
+};
+
+#endif /* __UART_REGISTRY_HPP */
@@ -0,0 +1,400 @@
+#ifndef __UART_RX_RING_HPP
+#define __UART_RX_RING_HPP
+
+// 标准库
+#include <atomic>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+// 第三方库
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/ioctl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <errno.h>
+
+#include "uart.hpp"
+
+/**
+ * @brief 无锁单生产者单消费者接收环形缓冲区
+ * @note 生产者（后台读线程）与消费者（应用线程）各自只修改自己的下标，
+ *       两个下标位于不同的缓存行，避免伪共享。
+ */
+class UartRxRing {
+public:
+    /**
+     * @brief 构造函数
+     * @param capacity : 容量（单位：字节），向上取整为2的幂
+     */
+    explicit UartRxRing(size_t capacity)
+        : _head(0)
+        , _tail(0)
+        , _spaceFd(-1)
+        , _spaceWaiting(false)
+        , _deferredBytes(0)
+        , _highWater(0) {
+            if (capacity == 0) {
+                throw std::invalid_argument("Ring capacity cannot be zero.");
+            }
+
+            size_t size = 1;
+            while (size < capacity) {
+                size <<= 1;
+            }
+
+            _buffer.resize(size);
+            _mask = size - 1;
+        } /* explicit UartRxRing(size_t capacity) { */
+
+    UartRxRing(const UartRxRing&)            = delete;
+    UartRxRing& operator=(const UartRxRing&) = delete;
+
+    /**
+     * @brief 根据波特率与延迟预算计算合适的容量
+     * @param uart      : 串口，使用其波特率、数据位、校验位与停止位
+     * @param latencyMs : 消费者最长可能多久不取数据（毫秒）
+     * @return 可容纳该时间内到达的全部数据的容量，留有一倍余量，最小为4KB
+     */
+    static size_t capacityFor(const Uart& uart, unsigned latencyMs) {
+        // 起始位 + 数据位 + 校验位 + 停止位
+        unsigned bitsPerChar = 1 + uart.getDataBits() + (uart.getParity() == 'N' ? 0 : 1) + uart.getStopBits();
+        size_t bytes = static_cast<size_t>(uart.getBaudRate()) / bitsPerChar * latencyMs / 1000 * 2;
+
+        return bytes < 4096 ? 4096 : bytes;
+    }
+
+    /**
+     * @brief 获取容量
+     */
+    size_t capacity() const {
+        return _buffer.size();
+    }
+
+    /**
+     * @brief 获取当前填充量（单位：字节）
+     * @note 生产者和消费者都可以调用，结果为瞬时值
+     */
+    size_t size() const {
+        return _head.load(std::memory_order_acquire) - _tail.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief 获取因缓冲区写满而滞留在内核tty缓冲区中的累计字节数
+     * @note 写满时后台读线程暂停读取，数据在内核中等待；持续增长说明容量不足，
+     *       内核缓冲区也满时后续数据由驱动丢弃或触发流控，无法在用户态计数
+     */
+    uint64_t getDeferredBytes() const {
+        return _deferredBytes.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 记录滞留的字节数
+     * @note 仅生产者调用
+     */
+    void markDeferred(size_t length) {
+        _deferredBytes.fetch_add(length, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 设置消费者腾出空间时通知的eventfd，-1表示不通知
+     * @note 必须在生产者与消费者开始工作之前设置
+     */
+    void setSpaceNotifier(int fd) {
+        _spaceFd = fd;
+    }
+
+    /**
+     * @brief 生产者登记等待空间
+     * @return 缓冲区仍然已满返回true，之后的consume()会写入setSpaceNotifier()设置的eventfd；
+     *         已有空间返回false
+     * @note 仅生产者调用
+     */
+    bool waitForSpace() {
+        _spaceWaiting.store(true, std::memory_order_relaxed);
+        // 与consume()中的栅栏配对：要么这里看到新的读位置，要么consume()看到等待标志
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if (_head.load(std::memory_order_relaxed) - _tail.load(std::memory_order_relaxed) < _buffer.size()) {
+            _spaceWaiting.store(false, std::memory_order_relaxed);
+            return false;
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief 获取历史最高填充量（单位：字节）
+     */
+    size_t getHighWater() const {
+        return _highWater.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 查看可读取的连续数据，不拷贝
+     * @return 从读位置开始的连续数据，数据在环尾回绕时只返回回绕前的部分
+     * @note 仅消费者调用
+     */
+    UartSpan peek() const {
+        size_t tail  = _tail.load(std::memory_order_relaxed);
+        size_t avail = _head.load(std::memory_order_acquire) - tail;
+        size_t index = tail & _mask;
+        size_t chunk = _buffer.size() - index;
+
+        UartSpan span = {&_buffer[index], avail < chunk ? avail : chunk};
+        return span;
+    }
+
+    /**
+     * @brief 丢弃已处理的数据，释放空间给生产者
+     * @param length : 丢弃的长度，不能超过size()
+     * @note 仅消费者调用
+     */
+    void consume(size_t length) {
+        _tail.store(_tail.load(std::memory_order_relaxed) + length, std::memory_order_release);
+
+        if (_spaceFd != -1) {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            if (_spaceWaiting.load(std::memory_order_relaxed) && _spaceWaiting.exchange(false)) {
+                uint64_t one = 1;
+                ssize_t ret = ::write(_spaceFd, &one, sizeof(one));
+                (void)ret;
+            }
+        }
+    } /* void consume(size_t length) { */
+
+    /**
+     * @brief 拷贝并丢弃数据
+     * @param buffer : 数据缓冲区基地址
+     * @param length : 拷贝的最大长度（单位：字节）
+     * @return 实际拷贝的长度
+     * @note 仅消费者调用
+     */
+    size_t read(char* buffer, size_t length) {
+        size_t copied = 0;
+
+        while (copied < length) {
+            UartSpan span = peek();
+
+            if (span.size == 0) {
+                break;
+            }
+
+            size_t n = length - copied < span.size ? length - copied : span.size;
+            std::memcpy(buffer + copied, span.data, n);
+            consume(n);
+            copied += n;
+        }
+
+        return copied;
+    } /* size_t read(char* buffer, size_t length) { */
+
+    /**
+     * @brief 从文件描述符读取数据填充空闲空间
+     * @return readv()系统调用的返回值，缓冲区已满时返回0且不进行系统调用
+     * @note 仅生产者调用。空闲空间在环尾回绕时使用readv()一次填充两段
+     */
+    ssize_t fill(int fd) {
+        size_t head = _head.load(std::memory_order_relaxed);
+        size_t used = head - _tail.load(std::memory_order_acquire);
+        size_t free = _buffer.size() - used;
+
+        if (free == 0) {
+            return 0;
+        }
+
+        size_t index = head & _mask;
+        size_t first = _buffer.size() - index;
+
+        struct iovec iov[2];
+        iov[0].iov_base = &_buffer[index];
+        iov[0].iov_len  = free < first ? free : first;
+        iov[1].iov_base = &_buffer[0];
+        iov[1].iov_len  = free - iov[0].iov_len;
+
+        ssize_t result = ::readv(fd, iov, iov[1].iov_len > 0 ? 2 : 1);
+
+        if (result > 0) {
+            _head.store(head + result, std::memory_order_release);
+
+            size_t level = used + result;
+            if (level > _highWater.load(std::memory_order_relaxed)) {
+                _highWater.store(level, std::memory_order_relaxed);
+            }
+        }
+
+        return result;
+    } /* ssize_t fill(int fd) { */
+
+private:
+    std::vector<char> _buffer;
+    size_t _mask;
+
+    alignas(64) std::atomic<size_t> _head;          // 写位置，仅生产者修改
+    alignas(64) std::atomic<size_t> _tail;          // 读位置，仅消费者修改
+    int _spaceFd;                                   // 腾出空间时通知的eventfd
+    alignas(64) std::atomic<bool> _spaceWaiting;    // 生产者正在等待空间
+    std::atomic<uint64_t> _deferredBytes;           // 滞留在内核中的累计字节数
+    std::atomic<size_t> _highWater;                 // 历史最高填充量
+};
+
+/**
+ * @brief 后台读线程，持续将串口数据读入UartRxRing
+ * @note 启动后应用线程不应再直接调用uart.receive()，而是从getRing()读取数据
+ */
+class UartReader {
+public:
+    /**
+     * @brief 构造函数
+     * @param uart      : 已打开的串口，其生命周期必须长于UartReader
+     * @param latencyMs : 消费者的延迟预算（毫秒），用于计算环形缓冲区的容量，默认为100
+     */
+    explicit UartReader(const Uart& uart, unsigned latencyMs = 100)
+        : _uart(uart)
+        , _ring(UartRxRing::capacityFor(uart, latencyMs))
+        , _stopFd(-1)
+        , _spaceFd(-1)
+        , _readErrors(0) {
+            if (!_uart.isOpen()) {
+                throw std::runtime_error("UART port is not open.");
+            }
+
+            _stopFd = ::eventfd(0, EFD_CLOEXEC);
+
+            if (_stopFd == -1) {
+                throw std::runtime_error("Error in creating stop eventfd.");
+            }
+
+            _spaceFd = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+
+            if (_spaceFd == -1) {
+                ::close(_stopFd);
+                throw std::runtime_error("Error in creating space eventfd.");
+            }
+
+            _ring.setSpaceNotifier(_spaceFd);
+
+            _thread = std::thread(&UartReader::loop, this);
+        } /* explicit UartReader(const Uart& uart, unsigned latencyMs = 100) { */
+
+    ~UartReader() {
+        stop();
+        ::close(_stopFd);
+        ::close(_spaceFd);
+    }
+
+    UartReader(const UartReader&)            = delete;
+    UartReader& operator=(const UartReader&) = delete;
+
+    /**
+     * @brief 停止后台读线程，已读入的数据仍可从环形缓冲区中取出
+     */
+    void stop() {
+        if (_thread.joinable()) {
+            uint64_t one = 1;
+            ssize_t ret = ::write(_stopFd, &one, sizeof(one));
+            (void)ret;
+            _thread.join();
+        }
+    }
+
+    /**
+     * @brief 获取接收环形缓冲区
+     */
+    UartRxRing& getRing() {
+        return _ring;
+    }
+
+    /**
+     * @brief 获取read()失败的次数（EAGAIN与EINTR除外），失败后读线程退出
+     */
+    uint64_t getReadErrors() const {
+        return _readErrors.load(std::memory_order_relaxed);
+    }
+
+private:
+    void loop() {
+        struct pollfd fds[3];
+        fds[0].fd     = _uart.getFd();
+        fds[0].events = POLLIN;
+        fds[1].fd     = _stopFd;
+        fds[1].events = POLLIN;
+        fds[2].fd     = _spaceFd;
+        fds[2].events = POLLIN;
+
+        bool stalled   = false;
+        size_t counted = 0; // 内核积压中已计入滞留字节数的部分，每个字节只计一次
+
+        for (;;) {
+            // 缓冲区已满时不再关注串口可读事件，由consume()通过eventfd唤醒
+            bool full = _ring.size() == _ring.capacity() && _ring.waitForSpace();
+
+            if (stalled && !full) {
+                // 停顿结束时内核中积压的数据，即因缓冲区写满而推迟读取的字节数
+                int queued = 0;
+
+                if (::ioctl(fds[0].fd, FIONREAD, &queued) == 0 && static_cast<size_t>(queued) > counted) {
+                    _ring.markDeferred(queued - counted);
+                    counted = queued;
+                }
+            }
+
+            stalled       = full;
+            fds[0].events = full ? 0 : POLLIN;
+
+            if (::poll(fds, 3, -1) == -1) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                break;
+            }
+
+            if (fds[1].revents & POLLIN) {
+                break;
+            }
+
+            if (fds[2].revents & POLLIN) {
+                uint64_t value;
+                ssize_t ret = ::read(_spaceFd, &value, sizeof(value));
+                (void)ret;
+            }
+
+            if (full) {
+                continue;
+            }
+
+            if (fds[0].revents & (POLLERR | POLLNVAL)) {
+                break;
+            }
+
+            if (fds[0].revents & (POLLIN | POLLHUP)) {
+                ssize_t result = _ring.fill(_uart.getFd());
+
+                if (result > 0) {
+                    counted = static_cast<size_t>(result) < counted ? counted - result : 0;
+                }
+
+                if (result == 0) {
+                    break; // 对端已关闭
+                }
+
+                if (result == -1 && errno != EAGAIN && errno != EINTR) {
+                    _readErrors.fetch_add(1, std::memory_order_relaxed);
+                    break;
+                }
+            }
+        } /* for (;;) { */
+    } /* void loop() { */
+
+    const Uart& _uart;                  // 数据来源
+    UartRxRing _ring;                   // 接收环形缓冲区
+    int _stopFd;                        // 用于唤醒并停止读线程的eventfd
+    int _spaceFd;                       // 消费者腾出空间时唤醒读线程的eventfd
+    std::atomic<uint64_t> _readErrors;  // read()失败次数
+    std::thread _thread;                // 后台读线程
+};
+
+#endif /* __UART_RX_RING_HPP */
@@ -0,0 +1,317 @@
+#ifndef __UART_SIMD_HPP
+#define __UART_SIMD_HPP
+
+// 标准库
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define UART_SIMD_X86 1
+#elif defined(__aarch64__) || (defined(__ARM_NEON) && defined(__arm__))
+#include <arm_neon.h>
+#define UART_SIMD_NEON 1
+#endif
+
+/**
+ * @brief 字节扫描使用的指令集
+ */
+enum class UartSimd {
+    Scalar, // 逐字节比较
+    Sse2,   // 每次16字节
+    Avx2,   // 每次32字节
+    Neon    // 每次16字节
+};
+
+/**
+ * @brief 当前CPU支持的最佳指令集，首次调用时检测
+ */
+inline UartSimd uartSimdLevel() {
+#if defined(UART_SIMD_X86)
+    static const UartSimd level = __builtin_cpu_supports("avx2") ? UartSimd::Avx2
+                                : __builtin_cpu_supports("sse2") ? UartSimd::Sse2
+                                : UartSimd::Scalar;
+    return level;
+#elif defined(UART_SIMD_NEON)
+    return UartSimd::Neon;
+#else
+    return UartSimd::Scalar;
+#endif
+}
+
+/**
+ * @brief 逐字节查找
+ */
+inline const char* uartFindByteScalar(const char* begin, const char* end, char value) {
+    for (const char* p = begin; p < end; ++p) {
+        if (*p == value) {
+            return p;
+        }
+    }
+
+    return end;
+}
+
+#if defined(UART_SIMD_X86)
+/**
+ * @brief SSE2查找，每次比较16字节，用movemask得到匹配位置
+ */
+__attribute__((target("sse2")))
+inline const char* uartFindByteSse2(const char* begin, const char* end, char value) {
+    const char* p = begin;
+    __m128i needle = _mm_set1_epi8(value);
+
+    while (end - p >= 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, needle));
+
+        if (mask != 0) {
+            return p + __builtin_ctz(mask);
+        }
+
+        p += 16;
+    }
+
+    return uartFindByteScalar(p, end, value);
+} /* inline const char* uartFindByteSse2(...) { */
+
+/**
+ * @brief AVX2查找，每次处理64字节（两个32字节向量合并判断），尾部交给SSE2
+ */
+__attribute__((target("avx2")))
+inline const char* uartFindByteAvx2(const char* begin, const char* end, char value) {
+    const char* p = begin;
+    __m256i needle = _mm256_set1_epi8(value);
+
+    while (end - p >= 64) {
+        __m256i a = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)), needle);
+        __m256i b = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32)), needle);
+
+        if (!_mm256_testz_si256(_mm256_or_si256(a, b), _mm256_or_si256(a, b))) {
+            uint32_t maskA = static_cast<uint32_t>(_mm256_movemask_epi8(a));
+
+            if (maskA != 0) {
+                return p + __builtin_ctz(maskA);
+            }
+
+            return p + 32 + __builtin_ctz(static_cast<uint32_t>(_mm256_movemask_epi8(b)));
+        }
+
+        p += 64;
+    } /* while (end - p >= 64) { */
+
+    while (end - p >= 32) {
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(
+            _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)), needle)));
+
+        if (mask != 0) {
+            return p + __builtin_ctz(mask);
+        }
+
+        p += 32;
+    }
+
+    return uartFindByteSse2(p, end, value);
+} /* inline const char* uartFindByteAvx2(...) { */
+#endif /* UART_SIMD_X86 */
+
+#if defined(UART_SIMD_NEON)
+/**
+ * @brief NEON查找，每次比较16字节
+ * @note NEON没有movemask，把比较结果的每个字节收窄为4位，得到64位掩码
+ */
+inline const char* uartFindByteNeon(const char* begin, const char* end, char value) {
+    const char* p = begin;
+    uint8x16_t needle = vdupq_n_u8(static_cast<uint8_t>(value));
+
+    while (end - p >= 16) {
+        uint8x16_t eq = vceqq_u8(vld1q_u8(reinterpret_cast<const uint8_t*>(p)), needle);
+        uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(eq), 4)), 0);
+
+        if (mask != 0) {
+            return p + (__builtin_ctzll(mask) >> 2);
+        }
+
+        p += 16;
+    }
+
+    return uartFindByteScalar(p, end, value);
+} /* inline const char* uartFindByteNeon(...) { */
+#endif /* UART_SIMD_NEON */
+
+/**
+ * @brief 用指定的指令集查找字节，CPU不支持时退回逐字节查找
+ * @return 第一个等于value的字节的地址，未找到返回end
+ */
+inline const char* uartFindByte(const char* begin, const char* end, char value, UartSimd level) {
+    switch (level) {
+#if defined(UART_SIMD_X86)
+        case UartSimd::Avx2:
+            if (uartSimdLevel() == UartSimd::Avx2) {
+                return uartFindByteAvx2(begin, end, value);
+            }
+            return uartFindByteScalar(begin, end, value);
+        case UartSimd::Sse2:
+            if (uartSimdLevel() != UartSimd::Scalar) {
+                return uartFindByteSse2(begin, end, value);
+            }
+            return uartFindByteScalar(begin, end, value);
+#endif
+#if defined(UART_SIMD_NEON)
+        case UartSimd::Neon:
+            return uartFindByteNeon(begin, end, value);
+#endif
+        default:
+            return uartFindByteScalar(begin, end, value);
+    } /* switch (level) { */
+}
+
+/**
+ * @brief 用当前CPU支持的最佳指令集查找字节
+ * @return 第一个等于value的字节的地址，未找到返回end
+ */
+inline const char* uartFindByte(const char* begin, const char* end, char value) {
+    return uartFindByte(begin, end, value, uartSimdLevel());
+}
+
+/**
+ * @brief 逐字节拷贝，直到遇到a或b
+ */
+inline const char* uartCopyUntilScalar(const char* begin, const char* end, char* out, char a, char b) {
+    for (const char* p = begin; p < end; ++p, ++out) {
+        char c = *p;
+
+        if (c == a || c == b) {
+            return p;
+        }
+
+        *out = c;
+    }
+
+    return end;
+}
+
+#if defined(UART_SIMD_X86)
+/**
+ * @brief SSE2拷贝，每次比较16字节，整块不含a、b时直接存入out
+ */
+__attribute__((target("sse2")))
+inline const char* uartCopyUntilSse2(const char* begin, const char* end, char* out, char a, char b) {
+    const char* p = begin;
+    __m128i va = _mm_set1_epi8(a);
+    __m128i vb = _mm_set1_epi8(b);
+
+    while (end - p >= 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        int mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(chunk, va), _mm_cmpeq_epi8(chunk, vb)));
+
+        if (mask != 0) {
+            size_t count = __builtin_ctz(mask);
+            std::memmove(out, p, count);
+            return p + count;
+        }
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), chunk);
+        p   += 16;
+        out += 16;
+    } /* while (end - p >= 16) { */
+
+    return uartCopyUntilScalar(p, end, out, a, b);
+} /* inline const char* uartCopyUntilSse2(...) { */
+
+/**
+ * @brief AVX2拷贝，每次比较32字节，尾部交给SSE2
+ */
+__attribute__((target("avx2")))
+inline const char* uartCopyUntilAvx2(const char* begin, const char* end, char* out, char a, char b) {
+    const char* p = begin;
+    __m256i va = _mm256_set1_epi8(a);
+    __m256i vb = _mm256_set1_epi8(b);
+
+    while (end - p >= 32) {
+        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(
+            _mm256_or_si256(_mm256_cmpeq_epi8(chunk, va), _mm256_cmpeq_epi8(chunk, vb))));
+
+        if (mask != 0) {
+            size_t count = __builtin_ctz(mask);
+            std::memmove(out, p, count);
+            return p + count;
+        }
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), chunk);
+        p   += 32;
+        out += 32;
+    } /* while (end - p >= 32) { */
+
+    return uartCopyUntilSse2(p, end, out, a, b);
+} /* inline const char* uartCopyUntilAvx2(...) { */
+#endif /* UART_SIMD_X86 */
+
+#if defined(UART_SIMD_NEON)
+/**
+ * @brief NEON拷贝，每次比较16字节
+ */
+inline const char* uartCopyUntilNeon(const char* begin, const char* end, char* out, char a, char b) {
+    const char* p = begin;
+    uint8x16_t va = vdupq_n_u8(static_cast<uint8_t>(a));
+    uint8x16_t vb = vdupq_n_u8(static_cast<uint8_t>(b));
+
+    while (end - p >= 16) {
+        uint8x16_t chunk = vld1q_u8(reinterpret_cast<const uint8_t*>(p));
+        uint8x16_t eq    = vorrq_u8(vceqq_u8(chunk, va), vceqq_u8(chunk, vb));
+        uint64_t mask    = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(eq), 4)), 0);
+
+        if (mask != 0) {
+            size_t count = __builtin_ctzll(mask) >> 2;
+            std::memmove(out, p, count);
+            return p + count;
+        }
+
+        vst1q_u8(reinterpret_cast<uint8_t*>(out), chunk);
+        p   += 16;
+        out += 16;
+    } /* while (end - p >= 16) { */
+
+    return uartCopyUntilScalar(p, end, out, a, b);
+} /* inline const char* uartCopyUntilNeon(...) { */
+#endif /* UART_SIMD_NEON */
+
+/**
+ * @brief 把[begin, end)中第一个a或b之前的数据拷贝到out，查找与拷贝在同一遍内完成
+ * @param out : 输出缓冲区，可写入的长度不小于end - begin；可以与输入重叠，但必须满足out <= begin
+ * @return 第一个等于a或b的字节的地址，未找到返回end；拷贝的字节数为返回值 - begin
+ * @note 只整块存入不含a、b的数据，不会写到拷贝范围之外
+ */
+inline const char* uartCopyUntil(const char* begin, const char* end, char* out, char a, char b, UartSimd level) {
+    switch (level) {
+#if defined(UART_SIMD_X86)
+        case UartSimd::Avx2:
+            if (uartSimdLevel() == UartSimd::Avx2) {
+                return uartCopyUntilAvx2(begin, end, out, a, b);
+            }
+            return uartCopyUntilScalar(begin, end, out, a, b);
+        case UartSimd::Sse2:
+            if (uartSimdLevel() != UartSimd::Scalar) {
+                return uartCopyUntilSse2(begin, end, out, a, b);
+            }
+            return uartCopyUntilScalar(begin, end, out, a, b);
+#endif
+#if defined(UART_SIMD_NEON)
+        case UartSimd::Neon:
+            return uartCopyUntilNeon(begin, end, out, a, b);
+#endif
+        default:
+            return uartCopyUntilScalar(begin, end, out, a, b);
+    } /* switch (level) { */
+}
+
+/**
+ * @brief 用当前CPU支持的最佳指令集拷贝，直到遇到a或b
+ */
+inline const char* uartCopyUntil(const char* begin, const char* end, char* out, char a, char b) {
+    return uartCopyUntil(begin, end, out, a, b, uartSimdLevel());
+}
+
+#endif /* __UART_SIMD_HPP */
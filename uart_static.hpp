@@ -0,0 +1,238 @@
+#ifndef __UART_STATIC_HPP
+#define __UART_STATIC_HPP
+
+// 标准库
+#include <cstddef>
+#include <cstring>
+
+// 第三方库
+#include <termios.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+
+/**
+ * @brief 奇偶校验方式
+ */
+enum class UartParity {
+    None, // 无校验
+    Even, // 偶校验
+    Odd   // 奇校验
+};
+
+/**
+ * @brief 流控制方式
+ */
+enum class UartFlow {
+    None,     // 无流控制
+    Hardware, // RTS/CTS硬件流控制
+    Software  // XON/XOFF软件流控制
+};
+
+/**
+ * @brief 编译期配置的串口，例如StaticUart<115200, UartParity::None, 8, 1, UartFlow::None>
+ * @note 所有参数在编译期检查，完整的termios标志位也在编译期生成，open()只需一次tcsetattr()，
+ *       没有运行时的参数校验，也不依赖<map>与uart.hpp，适合配置固定、对体积敏感的嵌入式目标。
+ *       串口固定工作在原始（二进制）模式，使用非阻塞读取。
+ *       接口不抛出异常，失败时返回false或-1并设置errno，可在-fno-exceptions下使用。
+ *       启用软件流控制时，数据中的0x11/0x13会被当作XON/XOFF而被驱动吞掉
+ */
+template <unsigned long Baud,
+          UartParity Parity = UartParity::None,
+          int DataBits      = 8,
+          int StopBits      = 1,
+          UartFlow Flow     = UartFlow::None>
+class StaticUart {
+public:
+    /**
+     * @brief 波特率对应的termios位图，不支持的波特率为0
+     */
+    static constexpr speed_t speed() {
+        return Baud ==      50 ?      B50 : Baud ==      75 ?      B75 : Baud ==     110 ?     B110 :
+               Baud ==     134 ?     B134 : Baud ==     150 ?     B150 : Baud ==     200 ?     B200 :
+               Baud ==     300 ?     B300 : Baud ==     600 ?     B600 : Baud ==    1200 ?    B1200 :
+               Baud ==    1800 ?    B1800 : Baud ==    2400 ?    B2400 : Baud ==    4800 ?    B4800 :
+               Baud ==    9600 ?    B9600 : Baud ==   19200 ?   B19200 : Baud ==   38400 ?   B38400 :
+               Baud ==   57600 ?   B57600 : Baud ==  115200 ?  B115200 : Baud ==  230400 ?  B230400 :
+               Baud ==  460800 ?  B460800 : Baud ==  500000 ?  B500000 : Baud ==  576000 ?  B576000 :
+               Baud ==  921600 ?  B921600 : Baud == 1000000 ? B1000000 : Baud == 1152000 ? B1152000 :
+               Baud == 1500000 ? B1500000 : Baud == 2000000 ? B2000000 : Baud == 2500000 ? B2500000 :
+               Baud == 3000000 ? B3000000 : Baud == 3500000 ? B3500000 : Baud == 4000000 ? B4000000 :
+               0;
+    }
+
+    static_assert(speed() != 0, "Invalid baud rate config.");
+    static_assert(DataBits >= 5 && DataBits <= 8, "Invalid data bits config.");
+    static_assert(StopBits == 1 || StopBits == 2, "Invalid stop bits config.");
+    // 5位数据位时CSTOPB在16550兼容的UART上产生1.5位停止位，而不是2位
+    static_assert(!(DataBits == 5 && StopBits == 2), "Invalid data bits and stop bits combination.");
+
+    /**
+     * @brief 控制模式标志：波特率、数据位、校验、停止位、硬件流控制，忽略调制解调器控制线并使能接收
+     */
+    static constexpr tcflag_t cflag() {
+        return speed()
+             | (DataBits == 5 ? CS5 : DataBits == 6 ? CS6 : DataBits == 7 ? CS7 : CS8)
+             | (Parity != UartParity::None ? PARENB : 0)
+             | (Parity == UartParity::Odd ? PARODD : 0)
+             | (StopBits == 2 ? CSTOPB : 0)
+             | (Flow == UartFlow::Hardware ? CRTSCTS : 0)
+             | CLOCAL | CREAD;
+    }
+
+    /**
+     * @brief 输入模式标志：开启校验时检查校验位，软件流控制
+     * @note 不设置ISTRIP，否则8位数据的最高位会被清零
+     */
+    static constexpr tcflag_t iflag() {
+        return (Parity != UartParity::None ? INPCK : 0)
+             | (Flow == UartFlow::Software ? (IXON | IXOFF | IXANY) : 0);
+    }
+
+    /**
+     * @brief 完整的termios配置
+     * @note 输出模式与本地模式全部清零（原始模式），一次read()至少读到1个字节（VMIN=1，VTIME=0）
+     */
+    static struct termios attributes() noexcept {
+        struct termios tty;
+        std::memset(&tty, 0, sizeof(tty));
+
+        tty.c_cflag       = cflag();
+        tty.c_iflag       = iflag();
+        tty.c_cc[VMIN]    = 1;
+        tty.c_cc[VTIME]   = 0;
+        tty.c_cc[VSTART]  = 0x11; // XON
+        tty.c_cc[VSTOP]   = 0x13; // XOFF
+#ifdef _HAVE_STRUCT_TERMIOS_C_ISPEED
+        tty.c_ispeed      = speed();
+        tty.c_ospeed      = speed();
+#endif
+
+        return tty;
+    }
+
+    /**
+     * @brief 构造函数
+     * @param port : 串口设备路径
+     * @note 不会打开串口
+     */
+    explicit StaticUart(const char* port) noexcept
+        : _port(port)
+        , _fd(-1) {}
+
+    ~StaticUart() {
+        close();
+    }
+
+    StaticUart(const StaticUart&)            = delete;
+    StaticUart& operator=(const StaticUart&) = delete;
+
+    /**
+     * @brief 打开串口并应用配置
+     * @return 状态，true串口打开成功，反之表示串口打开失败（errno说明原因）
+     */
+    bool open() noexcept {
+        if (_fd != -1) {
+            return true;
+        }
+
+        if (_port == nullptr) {
+            errno = EINVAL;
+            return false;
+        }
+
+        _fd = ::open(_port, O_RDWR | O_NOCTTY | O_NDELAY | O_CLOEXEC);
+
+        if (_fd == -1) {
+            return false;
+        }
+
+        struct termios tty = attributes();
+
+        if (tcsetattr(_fd, TCSANOW, &tty) == -1) {
+            int error = errno;
+            close();
+            errno = error;
+            return false;
+        }
+
+        return true;
+    } /* bool open() noexcept { */
+
+    /**
+     * @brief 关闭串口
+     */
+    void close() noexcept {
+        if (_fd != -1) {
+            ::close(_fd);
+            _fd = -1;
+        }
+    }
+
+    /**
+     * @brief 串口发送数据
+     * @param data   : 需要发送的数据的基地址
+     * @param length : 发送的数据的长度（单位：字节）
+     * @return 发送的数据长度，失败返回-1并设置errno
+     */
+    ssize_t send(const char* data, size_t length) const noexcept {
+        ssize_t result;
+
+        do {
+            result = ::write(_fd, data, length);
+        } while (result == -1 && errno == EINTR);
+
+        return result;
+    }
+
+    /**
+     * @brief 串口接收数据
+     * @param buffer : 数据缓冲区基地址
+     * @param length : 接收的数据的最大长度（单位：字节）
+     * @return 接收的数据长度，暂无数据时返回-1且errno为EAGAIN，其余失败返回-1并设置errno
+     * @note 不会在数据末尾写入'\0'
+     */
+    ssize_t receive(char* buffer, size_t length) const noexcept {
+        ssize_t result;
+
+        do {
+            result = ::read(_fd, buffer, length);
+        } while (result == -1 && errno == EINTR);
+
+        return result;
+    }
+
+    /**
+     * @brief 检查串口是否打开
+     */
+    bool isOpen() const noexcept {
+        return _fd != -1;
+    }
+
+    /**
+     * @brief 获取串口设备路径
+     */
+    const char* getPort() const noexcept {
+        return _port;
+    }
+
+    /**
+     * @brief 获取文件描述符
+     */
+    int getFd() const noexcept {
+        return _fd;
+    }
+
+    /**
+     * @brief 获取波特率
+     */
+    static constexpr unsigned long getBaudRate() {
+        return Baud;
+    }
+
+private:
+    const char* _port; // 串口设备路径
+    int _fd;           // 文件描述符
+};
+
+#endif /* __UART_STATIC_HPP */
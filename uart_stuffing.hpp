@@ -0,0 +1,395 @@
+#ifndef __UART_STUFFING_HPP
+#define __UART_STUFFING_HPP
+
+// 标准库
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "uart.hpp"
+#include "uart_simd.hpp"
+#include "uart_transport.hpp"
+
+/**
+ * @brief HDLC异步帧（RFC 1662）的转义规则：0x7E为帧标志，0x7D为转义字符，被转义的字节异或0x20
+ * @note 只转义0x7E与0x7D（ACCM为0）
+ */
+struct UartHdlcCodec {
+    static const char kFlag   = 0x7E;
+    static const char kEscape = 0x7D;
+
+    static char escape(char c) {
+        return static_cast<char>(c ^ 0x20);
+    }
+
+    /**
+     * @return 转义序列合法返回true
+     */
+    static bool unescape(char c, char& out) {
+        out = static_cast<char>(c ^ 0x20);
+        return true;
+    }
+};
+
+/**
+ * @brief SLIP（RFC 1055）的转义规则：0xC0为帧结束，0xDB为转义字符，0xC0写作0xDB 0xDC，0xDB写作0xDB 0xDD
+ */
+struct UartSlipCodec {
+    static const char kFlag   = '\xC0';
+    static const char kEscape = '\xDB';
+
+    static char escape(char c) {
+        return c == kFlag ? '\xDC' : '\xDD';
+    }
+
+    /**
+     * @return 转义序列合法返回true
+     */
+    static bool unescape(char c, char& out) {
+        out = c == '\xDC' ? '\xC0' : '\xDB';
+        return c == '\xDC' || c == '\xDD';
+    }
+};
+
+/**
+ * @brief 字节填充编码后的最大长度，含首尾两个帧标志
+ * @param length : 原始数据的长度（单位：字节）
+ */
+inline size_t uartStuffMaxEncodedSize(size_t length) {
+    return 2 * length + 2;
+}
+
+/**
+ * @brief 字节填充编码：帧标志 + 转义后的数据 + 帧标志
+ * @param data   : 原始数据的基地址
+ * @param length : 原始数据的长度（单位：字节）
+ * @param out    : 输出缓冲区，至少uartStuffMaxEncodedSize(length)字节，不能与data重叠
+ * @return 写入out的字节数
+ * @note 不需要转义的连续数据由uartCopyUntil()在查找特殊字节的同一遍内整块拷贝
+ */
+template <typename Codec>
+size_t uartStuffEncode(const char* data, size_t length, char* out) {
+    const char* p   = data;
+    const char* end = data + length;
+    char* dest      = out;
+
+    *dest++ = Codec::kFlag;
+
+    for (;;) {
+        const char* stop = uartCopyUntil(p, end, dest, Codec::kFlag, Codec::kEscape);
+        dest += stop - p;
+
+        if (stop == end) {
+            break;
+        }
+
+        *dest++ = Codec::kEscape;
+        *dest++ = Codec::escape(*stop);
+        p = stop + 1;
+    } /* for (;;) { */
+
+    *dest++ = Codec::kFlag;
+    return dest - out;
+} /* size_t uartStuffEncode(...) { */
+
+/**
+ * @brief 在UartTxQueue的槽位中直接编码一帧
+ * @param queue  : 发送队列，maxMessageSize不小于uartStuffMaxEncodedSize(length)
+ * @return 与UartTxQueue::send()相同
+ */
+template <typename Codec, typename Queue>
+bool uartStuffEnqueue(Queue& queue, const char* data, size_t length) {
+    if (data == nullptr) {
+        throw std::invalid_argument("Data cannot be nullptr.");
+    }
+
+    return queue.emplace(uartStuffMaxEncodedSize(length), [data, length](char* slot) {
+        return uartStuffEncode<Codec>(data, length, slot);
+    });
+}
+
+/**
+ * @brief 字节填充的增量解码器
+ * @note 数据可以按任意边界分段送入，转义字符落在两段之间也能正确处理。
+ *       反转义与拷贝在同一遍内完成：两个特殊字节之间的数据由uartCopyUntil()直接拷入帧缓冲区。
+ *       空帧（连续的帧标志）被忽略；超长帧、非法转义以及HDLC的中止序列（0x7D 0x7E）
+ *       使当前帧被丢弃并计入getErrors()，解码器在下一个帧标志处重新同步
+ */
+template <typename Codec>
+class UartStuffDecoder {
+public:
+    /**
+     * @brief 构造函数
+     * @param maxFrameSize : 解码后帧的最大长度（单位：字节），默认为4096
+     */
+    explicit UartStuffDecoder(size_t maxFrameSize = 4096)
+        : _frame(maxFrameSize)
+        , _size(0)
+        , _errors(0)
+        , _escaped(false)
+        , _discard(false) {
+            if (maxFrameSize == 0) {
+                throw std::invalid_argument("Invalid maximum frame size.");
+            }
+        }
+
+    /**
+     * @brief 送入一段接收到的数据
+     * @param data    : 数据的基地址
+     * @param length  : 数据的长度（单位：字节）
+     * @param handler : 形如void(UartSpan)的可调用对象，每解出一帧调用一次，帧在handler返回后失效
+     * @return 解出的帧数
+     */
+    template <typename Handler>
+    size_t feed(const char* data, size_t length, Handler&& handler) {
+        const char* p   = data;
+        const char* end = data + length;
+        size_t frames   = 0;
+
+        while (p < end) {
+            if (_discard) {
+                // 丢弃到下一个帧标志；帧标志从不出现在转义序列中，直接查找即可
+                p = uartFindByte(p, end, Codec::kFlag);
+
+                if (p == end) {
+                    break;
+                }
+
+                resync();
+                ++p;
+                continue;
+            } /* if (_discard) { */
+
+            if (_escaped) {
+                _escaped = false;
+                char c   = *p++;
+                char out;
+
+                if (c == Codec::kFlag || !Codec::unescape(c, out)) {
+                    drop();
+
+                    if (c == Codec::kFlag) {
+                        resync();
+                    }
+                } else if (_size == _frame.size()) {
+                    drop();
+                } else {
+                    _frame[_size++] = out;
+                }
+                continue;
+            } /* if (_escaped) { */
+
+            size_t space      = _frame.size() - _size;
+            const char* limit = static_cast<size_t>(end - p) > space ? p + space : end;
+            const char* stop  = uartCopyUntil(p, limit, _frame.data() + _size, Codec::kFlag, Codec::kEscape);
+
+            _size += stop - p;
+            p      = stop;
+
+            if (p == end) {
+                break;
+            }
+
+            if (p == limit && *p != Codec::kFlag && *p != Codec::kEscape) {
+                // 帧缓冲区已满，下一个字节仍是数据
+                drop();
+            } else if (*p == Codec::kEscape) {
+                _escaped = true;
+                ++p;
+            } else {
+                if (_size > 0) {
+                    UartSpan frame = {_frame.data(), _size};
+                    handler(frame);
+                    ++frames;
+                }
+
+                _size = 0;
+                ++p;
+            }
+        } /* while (p < end) { */
+
+        return frames;
+    } /* size_t feed(const char* data, size_t length, Handler&& handler) { */
+
+    /**
+     * @brief 获取被丢弃的帧数
+     */
+    uint64_t getErrors() const {
+        return _errors;
+    }
+
+    /**
+     * @brief 丢弃尚未完成的帧，回到初始状态
+     */
+    void reset() {
+        resync();
+    }
+
+private:
+    void drop() {
+        ++_errors;
+        _discard = true;
+    }
+
+    void resync() {
+        _size    = 0;
+        _escaped = false;
+        _discard = false;
+    }
+
+    std::vector<char> _frame; // 当前帧已解码的数据
+    size_t _size;             // 当前帧的长度
+    uint64_t _errors;         // 被丢弃的帧数
+    bool _escaped;            // 上一个字节是转义字符
+    bool _discard;            // 正在丢弃到下一个帧标志
+};
+
+/**
+ * @brief 字节填充帧接收器
+ * @note 每次读取到固定大小的接收缓冲区，再由UartStuffDecoder解码到帧缓冲区，
+ *       读取与解码都不分配内存。Transport默认为const Uart，也可以是UartTransport的派生类。
+ *       串口应使用默认的ReadPolicy::Any（非阻塞）读取策略
+ */
+template <typename Codec, typename Transport = const Uart>
+class UartStuffReader {
+public:
+    /**
+     * @brief 构造函数
+     * @param transport    : 数据来源，例如已打开的串口，其生命周期必须长于UartStuffReader
+     * @param maxFrameSize : 解码后帧的最大长度（单位：字节），默认为4096
+     * @param readSize     : 单次读取的最大长度（单位：字节），默认为4096
+     */
+    explicit UartStuffReader(Transport& transport, size_t maxFrameSize = 4096, size_t readSize = 4096)
+        : _transport(transport)
+        , _decoder(maxFrameSize)
+        , _buffer(readSize) {
+            if (readSize == 0) {
+                throw std::invalid_argument("Invalid read size.");
+            }
+        }
+
+    /**
+     * @brief 读取一次（非阻塞），把解出的帧依次交给handler
+     * @param handler : 形如void(UartSpan)的可调用对象
+     * @return 解出的帧数，暂无数据时为0
+     * @note 读取出错时抛出std::runtime_error
+     */
+    template <typename Handler>
+    size_t poll(Handler&& handler) {
+        UartResult result = UartIo<Transport>::read(_transport, _buffer.data(), _buffer.size());
+
+        if (!result.has_value()) {
+            if (result.error() == std::errc::operation_would_block) {
+                return 0;
+            }
+            throw std::runtime_error("Error in receiving data.");
+        }
+
+        return _decoder.feed(_buffer.data(), *result, handler);
+    } /* size_t poll(Handler&& handler) { */
+
+    /**
+     * @brief 在截止时间前读取，直到解出至少一帧
+     * @param handler  : 形如void(UartSpan)的可调用对象
+     * @param deadline : 截止时间，Uart::Clock::time_point::max()表示一直等待
+     * @return 解出的帧数，超时为0
+     * @note 串口通过Uart::receiveFor()等待；读取出错或对端关闭时抛出std::runtime_error
+     */
+    template <typename Handler>
+    size_t pollUntil(Handler&& handler, Uart::Clock::time_point deadline) {
+        size_t frames = 0;
+
+        while (frames == 0) {
+            UartProgress progress = UartIo<Transport>::readBefore(_transport, _buffer.data(), _buffer.size(), deadline);
+            frames += _decoder.feed(_buffer.data(), progress.bytes, handler);
+
+            if (progress.error == std::errc::timed_out) {
+                break;
+            }
+
+            if (progress.error) {
+                throw std::runtime_error("Error in receiving data.");
+            }
+        } /* while (frames == 0) { */
+
+        return frames;
+    } /* size_t pollUntil(Handler&& handler, Uart::Clock::time_point deadline) { */
+
+    /**
+     * @brief 获取被丢弃的帧数
+     */
+    uint64_t getErrors() const {
+        return _decoder.getErrors();
+    }
+
+private:
+    Transport& _transport;            // 数据来源
+    UartStuffDecoder<Codec> _decoder; // 增量解码
+    std::vector<char> _buffer;        // 接收缓冲区
+};
+
+/**
+ * @brief 字节填充帧发送器
+ * @note 构造时按最大帧长分配发送缓冲区，之后每帧直接编码进该缓冲区再写入串口，不再分配内存。
+ *       Transport默认为const Uart，也可以是UartTransport的派生类
+ */
+template <typename Codec, typename Transport = const Uart>
+class UartStuffWriter {
+public:
+    /**
+     * @brief 构造函数
+     * @param transport    : 发送目标，例如已打开的串口，其生命周期必须长于UartStuffWriter
+     * @param maxFrameSize : 原始帧的最大长度（单位：字节），默认为4096
+     */
+    explicit UartStuffWriter(Transport& transport, size_t maxFrameSize = 4096)
+        : _transport(transport)
+        , _buffer(uartStuffMaxEncodedSize(maxFrameSize))
+        , _maxFrameSize(maxFrameSize) {}
+
+    /**
+     * @brief 编码并发送一帧，串口不可写时等待
+     * @return 写入串口的字节数（含帧标志）
+     * @note 参数错误时抛出std::invalid_argument，发送出错时抛出std::runtime_error
+     */
+    size_t send(const char* data, size_t length) {
+        if (data == nullptr) {
+            throw std::invalid_argument("Data cannot be nullptr.");
+        }
+
+        if (length > _maxFrameSize) {
+            throw std::invalid_argument("Frame exceeds the maximum frame size.");
+        }
+
+        size_t total = uartStuffEncode<Codec>(data, length, _buffer.data());
+        size_t sent  = 0;
+
+        while (sent < total) {
+            UartResult result = UartIo<Transport>::write(_transport, _buffer.data() + sent, total - sent);
+
+            if (result.has_value()) {
+                sent += *result;
+            } else if (result.error() == std::errc::operation_would_block) {
+                UartIo<Transport>::waitWritable(_transport);
+            } else {
+                throw std::runtime_error("Error in sending data.");
+            }
+        } /* while (sent < total) { */
+
+        return total;
+    } /* size_t send(const char* data, size_t length) { */
+
+private:
+    Transport& _transport;     // 发送目标
+    std::vector<char> _buffer; // 发送缓冲区
+    size_t _maxFrameSize;      // 原始帧的最大长度
+};
+
+typedef UartStuffDecoder<UartHdlcCodec> UartHdlcDecoder;
+typedef UartStuffReader<UartHdlcCodec>  UartHdlcReader;
+typedef UartStuffWriter<UartHdlcCodec>  UartHdlcWriter;
+typedef UartStuffDecoder<UartSlipCodec> UartSlipDecoder;
+typedef UartStuffReader<UartSlipCodec>  UartSlipReader;
+typedef UartStuffWriter<UartSlipCodec>  UartSlipWriter;
+
+#endif /* __UART_STUFFING_HPP */
@@ -0,0 +1,649 @@
+#ifndef __UART_TRANSPORT_HPP
+#define __UART_TRANSPORT_HPP
+
+// 标准库
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// 第三方库
+#include <fcntl.h>
+#include <limits.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <termios.h>
+#include <unistd.h>
+#include <errno.h>
+
+#include "uart.hpp"
+
+/**
+ * @brief 传输层的公共接口（CRTP基类）
+ * @note 派生类实现以下三个函数，基类在编译期静态分发，没有虚函数开销：
+ *         UartResult writeSome(const char* data, size_t length) noexcept; // 非阻塞写，不可写时为operation_would_block
+ *         UartResult readSome(char* buffer, size_t length) noexcept;      // 非阻塞读，无数据时为operation_would_block
+ *         bool wait(short events, int timeoutMs) noexcept;               // 等待POLLIN/POLLOUT，超时返回false
+ *       协议栈以模板参数接收传输层，即可在真实串口、伪终端、进程内回环与Unix域套接字之间切换；
+ *       需要运行时选择时使用类型擦除的AnyTransport
+ */
+template <typename Derived>
+class UartTransport {
+public:
+    /**
+     * @brief 发送数据（非阻塞）
+     * @return 发送的数据长度；不可写时为std::errc::operation_would_block
+     */
+    UartResult send(const char* data, size_t length) noexcept {
+        return self().writeSome(data, length);
+    }
+
+    /**
+     * @brief 接收数据（非阻塞）
+     * @return 接收的数据长度；暂无数据时为std::errc::operation_would_block
+     * @note 不会在数据末尾写入'\0'
+     */
+    UartResult receive(char* buffer, size_t length) noexcept {
+        return self().readSome(buffer, length);
+    }
+
+    /**
+     * @brief 等待可读
+     * @param timeoutMs : 最长等待时间（毫秒），-1表示一直等待
+     * @return 可读返回true，超时返回false
+     */
+    bool waitReadable(int timeoutMs = -1) noexcept {
+        return self().wait(POLLIN, timeoutMs);
+    }
+
+    /**
+     * @brief 等待可写
+     * @param timeoutMs : 最长等待时间（毫秒），-1表示一直等待
+     * @return 可写返回true，超时返回false
+     */
+    bool waitWritable(int timeoutMs = -1) noexcept {
+        return self().wait(POLLOUT, timeoutMs);
+    }
+
+    /**
+     * @brief 发送全部数据，不可写时等待
+     * @return 成功时为length；失败时为错误码，此前已发送的数据无法撤回
+     */
+    UartResult sendAll(const char* data, size_t length) noexcept {
+        size_t sent = 0;
+
+        while (sent < length) {
+            UartResult result = self().writeSome(data + sent, length - sent);
+
+            if (result.has_value()) {
+                sent += *result;
+            } else if (result.error() == std::errc::operation_would_block) {
+                self().wait(POLLOUT, -1);
+            } else {
+                return result;
+            }
+        }
+
+        return sent;
+    } /* UartResult sendAll(const char* data, size_t length) noexcept { */
+
+protected:
+    Derived& self() noexcept {
+        return static_cast<Derived&>(*this);
+    }
+
+    /**
+     * @brief 用poll()等待文件描述符就绪
+     */
+    static bool pollFd(int fd, short events, int timeoutMs) noexcept {
+        struct pollfd pfd;
+        pfd.fd     = fd;
+        pfd.events = events;
+
+        int ret;
+
+        do {
+            ret = ::poll(&pfd, 1, timeoutMs);
+        } while (ret == -1 && errno == EINTR);
+
+        // 出错时交给随后的读写报告错误
+        return ret != 0;
+    }
+};
+
+/**
+ * @brief 帧读写器（UartBasicFrameReader、UartBasicCobsReader等）访问数据来源的方式
+ * @note 主模板适用于UartTransport的派生类，等待通过wait()完成；
+ *       Uart的特化直接调用其非阻塞接口，等待由Uart::receiveFor()在内核中完成
+ */
+template <typename Transport>
+struct UartIo {
+    static UartResult read(Transport& transport, char* buffer, size_t length) noexcept {
+        return transport.readSome(buffer, length);
+    }
+
+    static UartResult write(Transport& transport, const char* data, size_t length) noexcept {
+        return transport.writeSome(data, length);
+    }
+
+    static void waitWritable(Transport& transport) noexcept {
+        transport.wait(POLLOUT, -1);
+    }
+
+    /**
+     * @brief 在截止时间前读取一次
+     * @return 读到数据即返回；到期时error为std::errc::timed_out，对端关闭为std::errc::connection_reset
+     */
+    static UartProgress readBefore(Transport& transport, char* buffer, size_t length,
+                                   Uart::Clock::time_point deadline) noexcept {
+        UartProgress progress = {0, 0, std::error_code()};
+
+        for (;;) {
+            UartResult result = transport.readSome(buffer, length);
+
+            if (result.has_value()) {
+                progress.bytes = *result;
+
+                if (*result == 0 && length > 0) {
+                    progress.error = std::make_error_code(std::errc::connection_reset);
+                }
+                return progress;
+            }
+
+            if (result.error() != std::errc::operation_would_block) {
+                progress.error = result.error();
+                return progress;
+            }
+
+            int timeoutMs = -1;
+
+            if (deadline != Uart::Clock::time_point::max()) {
+                Uart::Clock::time_point now = Uart::Clock::now();
+
+                if (now >= deadline) {
+                    progress.error = std::make_error_code(std::errc::timed_out);
+                    return progress;
+                }
+
+                // 向上取整，避免在截止时间前反复以0超时空转
+                std::chrono::milliseconds::rep left =
+                    std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now).count() + 1;
+                timeoutMs = left < INT_MAX ? static_cast<int>(left) : INT_MAX;
+            }
+
+            transport.wait(POLLIN, timeoutMs);
+        } /* for (;;) { */
+    } /* static UartProgress readBefore(...) noexcept { */
+};
+
+template <>
+struct UartIo<const Uart> {
+    static UartResult read(const Uart& uart, char* buffer, size_t length) noexcept {
+        return uart.tryReceive(buffer, length);
+    }
+
+    static UartResult write(const Uart& uart, const char* data, size_t length) noexcept {
+        return uart.trySend(data, length);
+    }
+
+    static void waitWritable(const Uart& uart) noexcept {
+        struct pollfd fd = {uart.getFd(), POLLOUT, 0};
+        ::poll(&fd, 1, -1);
+    }
+
+    static UartProgress readBefore(const Uart& uart, char* buffer, size_t length,
+                                   Uart::Clock::time_point deadline) noexcept {
+        Uart::Clock::time_point now = Uart::Clock::now();
+        Uart::Clock::duration timeout = deadline > now ? deadline - now : Uart::Clock::duration::zero();
+
+        return uart.receiveFor(buffer, length, timeout);
+    }
+};
+
+template <>
+struct UartIo<Uart> : UartIo<const Uart> {};
+
+/**
+ * @brief 真实串口
+ * @note 直接调用Uart的非抛出接口，即read()/write()系统调用，读取策略等配置仍由Uart决定
+ */
+class TtyTransport : public UartTransport<TtyTransport> {
+public:
+    /**
+     * @brief 构造函数
+     * @param uart : 已打开的串口，移动进传输层
+     */
+    explicit TtyTransport(Uart&& uart)
+        : _uart(std::move(uart)) {
+            if (!_uart.isOpen()) {
+                throw std::runtime_error("UART port is not open.");
+            }
+        }
+
+    UartResult writeSome(const char* data, size_t length) noexcept {
+        return _uart.trySend(data, length);
+    }
+
+    UartResult readSome(char* buffer, size_t length) noexcept {
+        return _uart.tryReceive(buffer, length);
+    }
+
+    bool wait(short events, int timeoutMs) noexcept {
+        return pollFd(_uart.getFd(), events, timeoutMs);
+    }
+
+    /**
+     * @brief 获取串口，用于修改配置
+     */
+    Uart& getUart() noexcept {
+        return _uart;
+    }
+
+    int getFd() const noexcept {
+        return _uart.getFd();
+    }
+
+private:
+    Uart _uart; // 串口
+};
+
+/**
+ * @brief 基于文件描述符的传输层的公共实现
+ */
+template <typename Derived>
+class UartFdTransport : public UartTransport<Derived> {
+public:
+    UartResult writeSome(const char* data, size_t length) noexcept {
+        ssize_t result;
+
+        do {
+            result = ::write(_fd.get(), data, length);
+        } while (result == -1 && errno == EINTR);
+
+        if (result == -1) {
+            return Uart::errnoResult(errno);
+        }
+
+        return static_cast<size_t>(result);
+    }
+
+    UartResult readSome(char* buffer, size_t length) noexcept {
+        ssize_t result;
+
+        do {
+            result = ::read(_fd.get(), buffer, length);
+        } while (result == -1 && errno == EINTR);
+
+        if (result == -1) {
+            return Uart::errnoResult(errno);
+        }
+
+        return static_cast<size_t>(result);
+    }
+
+    bool wait(short events, int timeoutMs) noexcept {
+        return this->pollFd(_fd.get(), events, timeoutMs);
+    }
+
+    int getFd() const noexcept {
+        return _fd.get();
+    }
+
+protected:
+    explicit UartFdTransport(int fd) noexcept
+        : _fd(fd) {}
+
+    UartFd _fd; // 持有的文件描述符
+};
+
+/**
+ * @brief 伪终端
+ * @note openPair()返回的两端分别为设备端（从设备，已配置为原始模式，行为与串口相同）
+ *       与对端（主设备，模拟串口另一端的外设）
+ */
+class PtyTransport : public UartFdTransport<PtyTransport> {
+public:
+    /**
+     * @brief 创建一对伪终端
+     * @return first为设备端，second为对端，均为非阻塞
+     */
+    static std::pair<PtyTransport, PtyTransport> openPair() {
+        UartFd master(::posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC));
+
+        if (master.get() == -1 || ::grantpt(master.get()) == -1 || ::unlockpt(master.get()) == -1) {
+            throw std::runtime_error("Error in creating pseudo terminal.");
+        }
+
+        char path[64];
+
+        if (::ptsname_r(master.get(), path, sizeof(path)) != 0) {
+            throw std::runtime_error("Error in creating pseudo terminal.");
+        }
+
+        UartFd slave(::open(path, O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC));
+        struct termios tty;
+
+        if (slave.get() == -1 || tcgetattr(slave.get(), &tty) == -1) {
+            throw std::runtime_error("Error in opening pseudo terminal.");
+        }
+
+        cfmakeraw(&tty);
+
+        if (tcsetattr(slave.get(), TCSANOW, &tty) == -1) {
+            throw std::runtime_error("Error in settring attributes.");
+        }
+
+        return std::make_pair(PtyTransport(slave.release()), PtyTransport(master.release()));
+    } /* static std::pair<PtyTransport, PtyTransport> openPair() { */
+
+private:
+    explicit PtyTransport(int fd) noexcept
+        : UartFdTransport<PtyTransport>(fd) {}
+};
+
+/**
+ * @brief Unix域流式套接字
+ * @note 可连接到另一进程中的设备模拟器，或用openPair()在进程内创建一对
+ */
+class UnixSocketTransport : public UartFdTransport<UnixSocketTransport> {
+public:
+    /**
+     * @brief 创建一对相互连接的套接字
+     */
+    static std::pair<UnixSocketTransport, UnixSocketTransport> openPair() {
+        int fds[2];
+
+        if (::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0, fds) == -1) {
+            throw std::runtime_error("Error in creating socket pair.");
+        }
+
+        return std::make_pair(UnixSocketTransport(fds[0]), UnixSocketTransport(fds[1]));
+    }
+
+    /**
+     * @brief 连接到指定路径的Unix域套接字
+     * @param path : 套接字路径
+     */
+    static UnixSocketTransport connect(const char* path) {
+        if (path == nullptr) {
+            throw std::invalid_argument("Path cannot be nullptr.");
+        }
+
+        struct sockaddr_un addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+
+        if (strlen(path) >= sizeof(addr.sun_path)) {
+            throw std::invalid_argument("Socket path is too long.");
+        }
+
+        strcpy(addr.sun_path, path);
+
+        UnixSocketTransport transport(::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0));
+
+        if (transport.getFd() == -1
+            || ::connect(transport.getFd(), reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) == -1) {
+            throw std::runtime_error("Error in connecting to socket.");
+        }
+
+        // 连接完成后再切换为非阻塞
+        int flags = fcntl(transport.getFd(), F_GETFL);
+
+        if (flags == -1 || fcntl(transport.getFd(), F_SETFL, flags | O_NONBLOCK) == -1) {
+            throw std::runtime_error("Error in setting file status flags.");
+        }
+
+        return transport;
+    } /* static UnixSocketTransport connect(const char* path) { */
+
+    /**
+     * @brief 对端关闭后写入返回EPIPE，而不是触发SIGPIPE
+     */
+    UartResult writeSome(const char* data, size_t length) noexcept {
+        ssize_t result;
+
+        do {
+            result = ::send(_fd.get(), data, length, MSG_NOSIGNAL);
+        } while (result == -1 && errno == EINTR);
+
+        if (result == -1) {
+            return Uart::errnoResult(errno);
+        }
+
+        return static_cast<size_t>(result);
+    }
+
+private:
+    explicit UnixSocketTransport(int fd) noexcept
+        : UartFdTransport<UnixSocketTransport>(fd) {}
+};
+
+/**
+ * @brief 进程内回环
+ * @note 两端通过内存中的有界缓冲区相连，不产生系统调用，用于测试协议栈与测量其自身开销。
+ *       缓冲区满时写入返回operation_would_block，与串口驱动的发送缓冲区行为一致。
+ *       一端销毁后，另一端读完剩余数据后读到0（EOF），写入返回broken_pipe，与套接字相同。线程安全
+ */
+class LoopbackTransport : public UartTransport<LoopbackTransport> {
+public:
+    /**
+     * @brief 创建一对相连的回环端点
+     * @param capacity : 每个方向的缓冲区大小（单位：字节），默认为4096
+     */
+    static std::pair<LoopbackTransport, LoopbackTransport> openPair(size_t capacity = 4096) {
+        if (capacity == 0) {
+            throw std::invalid_argument("Invalid loopback capacity.");
+        }
+
+        std::shared_ptr<Channel> forward  = std::make_shared<Channel>(capacity);
+        std::shared_ptr<Channel> backward = std::make_shared<Channel>(capacity);
+
+        return std::make_pair(LoopbackTransport(backward, forward), LoopbackTransport(forward, backward));
+    }
+
+    LoopbackTransport(LoopbackTransport&&) noexcept = default;
+
+    LoopbackTransport& operator=(LoopbackTransport&& other) noexcept {
+        if (this != &other) {
+            close();
+            _rx = std::move(other._rx);
+            _tx = std::move(other._tx);
+        }
+        return *this;
+    }
+
+    ~LoopbackTransport() {
+        close();
+    }
+
+    UartResult writeSome(const char* data, size_t length) noexcept {
+        Channel& channel = *_tx;
+        std::lock_guard<std::mutex> lock(channel.mutex);
+
+        if (channel.closed) {
+            return Uart::makeError(std::make_error_code(std::errc::broken_pipe));
+        }
+
+        size_t count = channel.data.size() - channel.size;
+
+        if (count == 0) {
+            return Uart::makeError(std::make_error_code(std::errc::operation_would_block));
+        }
+
+        if (count > length) {
+            count = length;
+        }
+
+        for (size_t i = 0; i < count; ++i) {
+            channel.data[(channel.head + channel.size + i) % channel.data.size()] = data[i];
+        }
+
+        channel.size += count;
+        channel.cond.notify_all();
+
+        return count;
+    } /* UartResult writeSome(const char* data, size_t length) noexcept { */
+
+    UartResult readSome(char* buffer, size_t length) noexcept {
+        Channel& channel = *_rx;
+        std::lock_guard<std::mutex> lock(channel.mutex);
+
+        if (channel.size == 0) {
+            if (channel.closed) {
+                return static_cast<size_t>(0);
+            }
+            return Uart::makeError(std::make_error_code(std::errc::operation_would_block));
+        }
+
+        size_t count = channel.size < length ? channel.size : length;
+
+        for (size_t i = 0; i < count; ++i) {
+            buffer[i] = channel.data[(channel.head + i) % channel.data.size()];
+        }
+
+        channel.head  = (channel.head + count) % channel.data.size();
+        channel.size -= count;
+        channel.cond.notify_all();
+
+        return count;
+    } /* UartResult readSome(char* buffer, size_t length) noexcept { */
+
+    bool wait(short events, int timeoutMs) noexcept {
+        Channel& channel = (events & POLLIN) ? *_rx : *_tx;
+        std::unique_lock<std::mutex> lock(channel.mutex);
+
+        auto ready = [&channel, events]() {
+            return channel.closed || ((events & POLLIN) ? channel.size > 0 : channel.size < channel.data.size());
+        };
+
+        if (timeoutMs < 0) {
+            channel.cond.wait(lock, ready);
+            return true;
+        }
+
+        return channel.cond.wait_for(lock, std::chrono::milliseconds(timeoutMs), ready);
+    }
+
+    int getFd() const noexcept {
+        return -1;
+    }
+
+private:
+    /**
+     * @brief 单向的有界缓冲区
+     */
+    struct Channel {
+        explicit Channel(size_t capacity)
+            : data(capacity)
+            , head(0)
+            , size(0)
+            , closed(false) {}
+
+        std::mutex mutex;
+        std::condition_variable cond;
+        std::vector<char> data; // 环形缓冲区
+        size_t head;            // 读位置
+        size_t size;            // 已缓存的字节数
+        bool closed;            // 有一端已销毁
+    };
+
+    /**
+     * @brief 标记两个方向均已关闭并唤醒对端的等待者
+     */
+    void close() noexcept {
+        std::shared_ptr<Channel> channels[2] = {_rx, _tx};
+
+        for (size_t i = 0; i < 2; ++i) {
+            if (channels[i]) {
+                std::lock_guard<std::mutex> lock(channels[i]->mutex);
+                channels[i]->closed = true;
+                channels[i]->cond.notify_all();
+            }
+        }
+    }
+
+    LoopbackTransport(std::shared_ptr<Channel> rx, std::shared_ptr<Channel> tx)
+        : _rx(std::move(rx))
+        , _tx(std::move(tx)) {}
+
+    std::shared_ptr<Channel> _rx; // 接收方向
+    std::shared_ptr<Channel> _tx; // 发送方向
+};
+
+/**
+ * @brief 类型擦除的传输层，用于在运行时选择传输方式
+ * @note 每次读写经过一次虚函数调用；对延迟敏感的生产路径应直接使用具体的传输层类型
+ */
+class AnyTransport : public UartTransport<AnyTransport> {
+public:
+    /**
+     * @brief 构造函数
+     * @param transport : 任意传输层，移动进AnyTransport
+     */
+    template <typename Transport>
+    explicit AnyTransport(Transport&& transport)
+        : _impl(new Model<typename std::decay<Transport>::type>(std::forward<Transport>(transport))) {}
+
+    UartResult writeSome(const char* data, size_t length) noexcept {
+        return _impl->writeSome(data, length);
+    }
+
+    UartResult readSome(char* buffer, size_t length) noexcept {
+        return _impl->readSome(buffer, length);
+    }
+
+    bool wait(short events, int timeoutMs) noexcept {
+        return _impl->wait(events, timeoutMs);
+    }
+
+    /**
+     * @brief 获取文件描述符，进程内回环为-1
+     */
+    int getFd() const noexcept {
+        return _impl->getFd();
+    }
+
+private:
+    struct Concept {
+        virtual ~Concept() {}
+        virtual UartResult writeSome(const char* data, size_t length) noexcept = 0;
+        virtual UartResult readSome(char* buffer, size_t length) noexcept = 0;
+        virtual bool wait(short events, int timeoutMs) noexcept = 0;
+        virtual int getFd() const noexcept = 0;
+    };
+
+    template <typename Transport>
+    struct Model : Concept {
+        explicit Model(Transport&& impl)
+            : transport(std::move(impl)) {}
+
+        UartResult writeSome(const char* data, size_t length) noexcept override {
+            return transport.writeSome(data, length);
+        }
+
+        UartResult readSome(char* buffer, size_t length) noexcept override {
+            return transport.readSome(buffer, length);
+        }
+
+        bool wait(short events, int timeoutMs) noexcept override {
+            return transport.wait(events, timeoutMs);
+        }
+
+        int getFd() const noexcept override {
+            return transport.getFd();
+        }
+
+        Transport transport;
+    };
+
+    std::unique_ptr<Concept> _impl; // 实际的传输层
+};
+
+#endif /* __UART_TRANSPORT_HPP */
@@ -0,0 +1,409 @@
+#ifndef __UART_TX_QUEUE_HPP
+#define __UART_TX_QUEUE_HPP
+
+// 标准库
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+// 第三方库
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <errno.h>
+
+#include "uart.hpp"
+
+/**
+ * @brief 异步批量发送引擎
+ * @note 生产者通过send()将消息拷贝进有界无锁多生产者单消费者队列后立即返回，
+ *       后台写线程把队列中连续的多条消息直接组成iovec数组，用一次writev()发送，
+ *       并负责处理部分写入与EAGAIN（通过poll()等待可写）。
+ *       队列的每个槽位都有固定大小的内联存储，写线程直接引用槽位内存，不做二次拷贝。
+ */
+class UartTxQueue {
+public:
+    /**
+     * @brief 构造函数
+     * @param uart           : 已打开的串口，其生命周期必须长于UartTxQueue
+     * @param slots          : 队列槽位数，向上取整为2的幂，默认为1024
+     * @param maxMessageSize : 单条消息的最大长度（单位：字节），默认为256
+     */
+    explicit UartTxQueue(const Uart& uart, size_t slots = 1024, size_t maxMessageSize = 256)
+        : _uart(uart)
+        , _maxMessageSize(maxMessageSize)
+        , _enqueuePos(0)
+        , _dequeuePos(0)
+        , _offset(0)
+        , _sleeping(false)
+        , _stopping(false)
+        , _expired(false)
+        , _wakeFd(-1)
+        , _bytesWritten(0)
+        , _dropped(0)
+        , _writeErrors(0) {
+            if (!_uart.isOpen()) {
+                throw std::runtime_error("UART port is not open.");
+            }
+
+            if (slots == 0 || maxMessageSize == 0) {
+                throw std::invalid_argument("Invalid TX queue config.");
+            }
+
+            size_t size = 1;
+            while (size < slots) {
+                size <<= 1;
+            }
+
+            _mask  = size - 1;
+            _cells = std::vector<Cell>(size);
+            _arena.resize(size * maxMessageSize);
+
+            for (size_t i = 0; i < size; ++i) {
+                _cells[i].seq.store(i, std::memory_order_relaxed);
+            }
+
+            _wakeFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+            if (_wakeFd == -1) {
+                throw std::runtime_error("Error in creating wakeup eventfd.");
+            }
+
+            _thread = std::thread(&UartTxQueue::loop, this);
+        } /* explicit UartTxQueue(const Uart& uart, ...) { */
+
+    /**
+     * @brief 析构函数，会先发送完队列中剩余的消息
+     */
+    ~UartTxQueue() {
+        stop();
+        ::close(_wakeFd);
+    }
+
+    UartTxQueue(const UartTxQueue&)            = delete;
+    UartTxQueue& operator=(const UartTxQueue&) = delete;
+
+    /**
+     * @brief 将消息放入发送队列
+     * @param data   : 需要发送的数据的基地址
+     * @param length : 发送的数据的长度（单位：字节），不能超过maxMessageSize
+     * @return 入队成功返回true；队列已满返回false，消息被丢弃并计入getDropped()
+     * @note 线程安全，可被多个生产者同时调用，不会阻塞，通常也不会产生系统调用
+     */
+    bool send(const char* data, size_t length) {
+        if (data == nullptr) {
+            throw std::invalid_argument("Data cannot be nullptr.");
+        }
+
+        if (length == 0) {
+            return true;
+        }
+
+        return emplace(length, [data, length](char* slot) {
+            std::memcpy(slot, data, length);
+            return length;
+        });
+    } /* bool send(const char* data, size_t length) { */
+
+    /**
+     * @brief 在队列槽位中直接生成消息，用于编码（COBS、HDLC等）时省去一次拷贝
+     * @param maxLength : 消息的最大长度（单位：字节），不能超过maxMessageSize
+     * @param writer    : 形如size_t(char* slot)的可调用对象，向slot写入消息并返回实际长度（不超过maxLength）
+     * @return 与send()相同
+     * @note 线程安全；writer在槽位已占用后调用，应尽快返回。
+     *       writer抛出异常时槽位以长度0发布（不发送任何数据），异常继续向外传播；
+     *       writer返回的长度超过maxLength时同样以长度0发布，并抛出std::length_error
+     */
+    template <typename Writer>
+    bool emplace(size_t maxLength, Writer&& writer) {
+        if (maxLength > _maxMessageSize) {
+            throw std::invalid_argument("Message exceeds the maximum message size.");
+        }
+
+        size_t pos = _enqueuePos.load(std::memory_order_relaxed);
+        Cell* cell;
+
+        for (;;) {
+            cell = &_cells[pos & _mask];
+            size_t seq = cell->seq.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+
+            if (diff == 0) {
+                if (_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                _dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            } else {
+                pos = _enqueuePos.load(std::memory_order_relaxed);
+            }
+        } /* for (;;) { */
+
+        {
+            // 槽位已被占用，无论writer是否抛出异常都必须发布，否则写线程会永远停在这里
+            Publisher publisher(cell, pos + 1);
+            cell->length = 0;
+            size_t length = writer(&_arena[(pos & _mask) * _maxMessageSize]);
+
+            // 超出maxLength的长度会让写线程越过槽位读取相邻消息乃至存储区之外的内存
+            if (length > maxLength) {
+                throw std::length_error("Writer returned a length exceeding maxLength.");
+            }
+
+            cell->length = length;
+        }
+
+        // 只有写线程已经（或即将）休眠时才需要唤醒它
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if (_sleeping.load(std::memory_order_relaxed) && _sleeping.exchange(false)) {
+            wake();
+        }
+
+        return true;
+    } /* bool emplace(size_t maxLength, Writer&& writer) { */
+
+    /**
+     * @brief 停止写线程
+     * @param timeout : 发送剩余消息的最长时间，默认一直等待
+     * @return 剩余消息全部发送完毕返回true；超时返回false，未发送的消息被丢弃并计入getDropped()
+     * @note 会先发送完队列中剩余的消息；发送出错时剩余消息被丢弃。
+     *       对端不再接收（如流控一直有效）时，只有设置了timeout才能保证返回
+     */
+    bool stop(Uart::Clock::duration timeout = Uart::Clock::duration::max()) {
+        if (_thread.joinable()) {
+            Uart::Clock::time_point now = Uart::Clock::now();
+            _drainDeadline = timeout >= Uart::Clock::time_point::max() - now ? Uart::Clock::time_point::max()
+                                                                              : now + timeout;
+            _stopping.store(true);
+            wake();
+            _thread.join();
+        }
+
+        return !_expired;
+    } /* bool stop(Uart::Clock::duration timeout = ...) { */
+
+    /**
+     * @brief 获取已写入串口的字节数
+     */
+    uint64_t getBytesWritten() const {
+        return _bytesWritten.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 获取因队列已满而被丢弃的消息数
+     */
+    uint64_t getDropped() const {
+        return _dropped.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 获取writev()失败的次数（EAGAIN与EINTR除外）
+     */
+    uint64_t getWriteErrors() const {
+        return _writeErrors.load(std::memory_order_relaxed);
+    }
+
+private:
+    // 单次writev()最多合并的消息数
+    static const int kMaxBatch = 64;
+
+    /**
+     * @brief 队列槽位，seq用于判断槽位状态（Vyukov有界队列）
+     */
+    struct Cell {
+        std::atomic<size_t> seq;
+        size_t length;
+    };
+
+    /**
+     * @brief 离开作用域时发布槽位
+     */
+    struct Publisher {
+        Cell* cell;
+        size_t seq;
+
+        Publisher(Cell* c, size_t s) : cell(c), seq(s) {}
+
+        ~Publisher() {
+            cell->seq.store(seq, std::memory_order_release);
+        }
+    };
+
+    void wake() {
+        uint64_t one = 1;
+        ssize_t ret = ::write(_wakeFd, &one, sizeof(one));
+        (void)ret;
+    }
+
+    /**
+     * @brief 收集从读位置开始已就绪的消息
+     * @return iovec个数
+     */
+    int gather(struct iovec* iov) {
+        int count = 0;
+
+        while (count < kMaxBatch) {
+            size_t pos = _dequeuePos + count;
+            Cell& cell = _cells[pos & _mask];
+
+            if (cell.seq.load(std::memory_order_acquire) != pos + 1) {
+                break;
+            }
+
+            size_t skip = count == 0 ? _offset : 0;
+            iov[count].iov_base = &_arena[(pos & _mask) * _maxMessageSize + skip];
+            iov[count].iov_len  = cell.length - skip;
+            ++count;
+        }
+
+        return count;
+    } /* int gather(struct iovec* iov) { */
+
+    /**
+     * @brief 释放已完整发送的消息，记录部分发送的偏移
+     * @note emplace()可能产生长度为0的消息，它们在written用完后也要释放，否则会一直占住读位置
+     */
+    void advance(size_t written) {
+        for (;;) {
+            Cell& cell = _cells[_dequeuePos & _mask];
+
+            if (written == 0 && (cell.seq.load(std::memory_order_acquire) != _dequeuePos + 1 || cell.length != 0)) {
+                return;
+            }
+
+            size_t remain = cell.length - _offset;
+
+            if (written < remain) {
+                _offset += written;
+                return;
+            }
+
+            written -= remain;
+            _offset  = 0;
+            cell.seq.store(_dequeuePos + _mask + 1, std::memory_order_release);
+            ++_dequeuePos;
+        } /* for (;;) { */
+    } /* void advance(size_t written) { */
+
+    /**
+     * @brief 丢弃从读位置开始的count条消息
+     */
+    void discard(int count) {
+        for (int i = 0; i < count; ++i) {
+            _cells[_dequeuePos & _mask].seq.store(_dequeuePos + _mask + 1, std::memory_order_release);
+            ++_dequeuePos;
+        }
+
+        _offset = 0;
+        _dropped.fetch_add(count, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 是否已超过stop()给出的发送期限
+     */
+    bool drainExpired() const {
+        return _stopping.load() && Uart::Clock::now() >= _drainDeadline;
+    }
+
+    /**
+     * @brief 等待事件
+     * @param writable : 是否同时等待串口可写
+     * @note 停止过程中最多等到发送期限
+     */
+    void wait(bool writable) {
+        struct pollfd fds[2];
+        fds[0].fd     = _wakeFd;
+        fds[0].events = POLLIN;
+        fds[1].fd     = _uart.getFd();
+        fds[1].events = POLLOUT;
+
+        int timeoutMs = -1;
+
+        if (_stopping.load() && _drainDeadline != Uart::Clock::time_point::max()) {
+            Uart::Clock::duration remain = _drainDeadline - Uart::Clock::now();
+            timeoutMs = remain.count() > 0
+                      ? static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(remain).count()) + 1
+                      : 0;
+        }
+
+        if (::poll(fds, writable ? 2 : 1, timeoutMs) > 0 && (fds[0].revents & POLLIN)) {
+            uint64_t value;
+            ssize_t ret = ::read(_wakeFd, &value, sizeof(value));
+            (void)ret;
+        }
+    }
+
+    void loop() {
+        struct iovec iov[kMaxBatch];
+
+        for (;;) {
+            int count = gather(iov);
+
+            if (count == 0) {
+                if (_stopping.load()) {
+                    break;
+                }
+
+                // 先声明即将休眠再检查队列，保证不会错过生产者的唤醒
+                _sleeping.store(true);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+
+                if (gather(iov) == 0 && !_stopping.load()) {
+                    wait(false);
+                }
+
+                _sleeping.store(false);
+                continue;
+            } /* if (count == 0) { */
+
+            if (drainExpired()) {
+                do {
+                    discard(count);
+                } while ((count = gather(iov)) > 0);
+
+                _expired = true;
+                break;
+            }
+
+            ssize_t result = ::writev(_uart.getFd(), iov, count);
+
+            if (result >= 0) {
+                _bytesWritten.fetch_add(result, std::memory_order_relaxed);
+                advance(static_cast<size_t>(result));
+            } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                wait(true);
+            } else if (errno != EINTR) {
+                _writeErrors.fetch_add(1, std::memory_order_relaxed);
+                discard(count);
+            }
+        } /* for (;;) { */
+    } /* void loop() { */
+
+    const Uart& _uart;                   // 发送目标
+    size_t _maxMessageSize;              // 单条消息的最大长度
+    size_t _mask;                        // 槽位数 - 1
+    std::vector<Cell> _cells;            // 槽位状态
+    std::vector<char> _arena;            // 槽位的内联存储
+
+    alignas(64) std::atomic<size_t> _enqueuePos; // 生产者的写位置
+    alignas(64) size_t _dequeuePos;      // 写线程的读位置
+    size_t _offset;                      // 读位置处消息已发送的字节数
+    alignas(64) std::atomic<bool> _sleeping; // 写线程是否正在休眠
+    std::atomic<bool> _stopping;         // 是否已请求停止
+    Uart::Clock::time_point _drainDeadline; // 停止时发送剩余消息的期限，在_stopping之前写入
+    bool _expired;                       // 是否因超过期限而丢弃了剩余消息，由写线程写入
+    int _wakeFd;                         // 用于唤醒写线程的eventfd
+
+    std::atomic<uint64_t> _bytesWritten; // 已写入的字节数
+    std::atomic<uint64_t> _dropped;      // 丢弃的消息数
+    std::atomic<uint64_t> _writeErrors;  // writev()失败次数
+    std::thread _thread;                 // 后台写线程
+};
+
+#endif /* __UART_TX_QUEUE_HPP */
@@ -0,0 +1,545 @@
+#ifndef __UART_URING_HPP
+#define __UART_URING_HPP
+
+// 标准库
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+#include <vector>
+
+// 第三方库
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <errno.h>
+
+#include "uart.hpp"
+
+/**
+ * @brief io_uring完成事件
+ */
+struct UartCompletion {
+    uint64_t userData; // 提交时传入的用户数据
+    int result;        // 成功时为传输的字节数，失败时为-errno
+    int bufferId;      // 多发读取所使用的缓冲区编号，未使用时为-1
+    bool more;         // 为true表示该多发读取仍然有效，后续还会产生完成事件
+};
+
+/**
+ * @brief 基于io_uring的批量串口I/O引擎
+ * @note 多个串口的读写请求先写入提交队列，再通过一次io_uring_enter()批量提交，
+ *       从而把每次读写一个系统调用降低为每批一个系统调用。
+ *       内核不支持io_uring（或被seccomp禁止）时自动回退为同步的read()/write()，
+ *       调用方式保持不变，可通过isUringEnabled()查询当前使用的后端。
+ *       对于串口这类可poll的文件，读请求在无数据时由内核挂起，直到数据到达才完成，
+ *       不会占用调用线程；回退路径下则与receive()一致，无数据时以-EAGAIN完成。
+ */
+class UartUring {
+public:
+    /**
+     * @brief 构造函数
+     * @param entries : 提交队列的深度，默认为256
+     */
+    explicit UartUring(unsigned entries = 256)
+        : _ringFd(-1)
+        , _sqPtr(nullptr)
+        , _cqPtr(nullptr)
+        , _sqes(nullptr)
+        , _sqSize(0)
+        , _cqSize(0)
+        , _sqesSize(0)
+        , _toSubmit(0)
+        , _multishot(false)
+        , _bufSize(0)
+        , _internalCompletions(0)
+        , _internalErrors(0)
+        , _lastInternalError(0) {
+            setup(entries);
+        } /* explicit UartUring(unsigned entries = 256) { */
+
+    ~UartUring() {
+        teardown();
+    }
+
+    UartUring(const UartUring&)            = delete;
+    UartUring& operator=(const UartUring&) = delete;
+
+    /**
+     * @brief 是否正在使用io_uring后端
+     * @return true表示使用io_uring，false表示回退到同步read()/write()
+     */
+    bool isUringEnabled() const {
+        return _ringFd != -1;
+    }
+
+    /**
+     * @brief 内核是否支持多发读取（IORING_OP_READ_MULTISHOT，Linux 6.7+）
+     */
+    bool supportsMultishotRead() const {
+        return _multishot;
+    }
+
+    /**
+     * @brief 获取内部请求（提供/归还缓冲区）的完成事件数
+     * @note 内部完成事件不交给reap()的回调，只在这里计数
+     */
+    uint64_t getInternalCompletions() const {
+        return _internalCompletions;
+    }
+
+    /**
+     * @brief 获取失败的内部请求数
+     * @note 例如缓冲区编号越界或内核不支持IORING_OP_PROVIDE_BUFFERS，失败后多发读取会因缓冲区耗尽而结束
+     */
+    uint64_t getInternalErrors() const {
+        return _internalErrors;
+    }
+
+    /**
+     * @brief 获取最近一次失败的内部请求的错误码，从未失败时为空
+     */
+    std::error_code getLastInternalError() const {
+        return _lastInternalError == 0 ? std::error_code()
+                                       : std::error_code(_lastInternalError, std::generic_category());
+    }
+
+    /**
+     * @brief 注册固定缓冲区，供prepareReadFixed()/prepareWriteFixed()使用
+     * @param iov   : 缓冲区数组
+     * @param count : 缓冲区个数
+     * @note 注册后内核不再需要在每次I/O时映射用户页面
+     */
+    void registerBuffers(const struct iovec* iov, unsigned count) {
+        if (iov == nullptr || count == 0) {
+            throw std::invalid_argument("Buffers cannot be empty.");
+        }
+
+        if (!_fixed.empty()) {
+            throw std::logic_error("Buffers are already registered.");
+        }
+
+        if (isUringEnabled()
+            && syscall(__NR_io_uring_register, _ringFd, IORING_REGISTER_BUFFERS, iov, count) == -1) {
+            throw std::runtime_error("Error in registering io_uring buffers.");
+        }
+
+        _fixed.assign(iov, iov + count);
+    } /* void registerBuffers(const struct iovec* iov, unsigned count) { */
+
+    /**
+     * @brief 向内核提供多发读取所使用的缓冲区池
+     * @param count : 缓冲区个数
+     * @param size  : 单个缓冲区的大小（单位：字节）
+     * @note 每个多发读取的完成事件会占用一个缓冲区，处理完毕后需调用recycleBuffer()归还。
+     *       提供与归还缓冲区的请求随下一次submit()一起提交，不额外产生系统调用。
+     */
+    void provideBuffers(unsigned count, unsigned size) {
+        if (!supportsMultishotRead()) {
+            throw std::logic_error("Multishot read is not supported.");
+        }
+
+        if (count == 0 || count > 65536 || size == 0) {
+            throw std::invalid_argument("Invalid buffer pool config.");
+        }
+
+        if (!_bufPool.empty()) {
+            throw std::logic_error("Buffers are already provided.");
+        }
+
+        _bufSize = size;
+        _bufPool.assign(static_cast<size_t>(count) * size, 0);
+
+        struct io_uring_sqe* sqe = queue(IORING_OP_PROVIDE_BUFFERS, count, &_bufPool[0], size, kInternal);
+        sqe->buf_group = kBufferGroup;
+    } /* void provideBuffers(unsigned count, unsigned size) { */
+
+    /**
+     * @brief 获取缓冲区池中指定编号的缓冲区
+     */
+    char* getBuffer(int bufferId) {
+        return &_bufPool[static_cast<size_t>(bufferId) * _bufSize];
+    }
+
+    /**
+     * @brief 归还多发读取使用过的缓冲区
+     */
+    void recycleBuffer(int bufferId) {
+        struct io_uring_sqe* sqe = queue(IORING_OP_PROVIDE_BUFFERS, 1, getBuffer(bufferId), _bufSize, kInternal);
+        sqe->off       = static_cast<uint64_t>(bufferId);
+        sqe->buf_group = kBufferGroup;
+    }
+
+    /**
+     * @brief 添加读请求
+     * @param uart     : 已打开的串口
+     * @param buffer   : 数据缓冲区基地址
+     * @param length   : 接收的数据的最大长度（单位：字节）
+     * @param userData : 用户数据，原样出现在完成事件中
+     */
+    void prepareRead(const Uart& uart, char* buffer, unsigned length, uint64_t userData) {
+        if (buffer == nullptr) {
+            throw std::invalid_argument("Buffer cannot be nullptr.");
+        }
+
+        queue(IORING_OP_READ, fdOf(uart), buffer, length, userData);
+    }
+
+    /**
+     * @brief 添加写请求
+     * @param uart     : 已打开的串口
+     * @param data     : 需要发送的数据的基地址，完成之前必须保持有效
+     * @param length   : 发送的数据的长度（单位：字节）
+     * @param userData : 用户数据，原样出现在完成事件中
+     */
+    void prepareWrite(const Uart& uart, const char* data, unsigned length, uint64_t userData) {
+        if (data == nullptr) {
+            throw std::invalid_argument("Data cannot be nullptr.");
+        }
+
+        queue(IORING_OP_WRITE, fdOf(uart), data, length, userData);
+    }
+
+    /**
+     * @brief 使用固定缓冲区添加读请求
+     * @param index  : registerBuffers()中缓冲区的下标
+     * @param offset : 缓冲区内的偏移
+     */
+    void prepareReadFixed(const Uart& uart, unsigned index, unsigned offset, unsigned length, uint64_t userData) {
+        struct io_uring_sqe* sqe = queue(IORING_OP_READ_FIXED, fdOf(uart), fixedAddress(index, offset, length), length, userData);
+
+        if (sqe != nullptr) {
+            sqe->buf_index = static_cast<uint16_t>(index);
+        }
+    }
+
+    /**
+     * @brief 使用固定缓冲区添加写请求
+     * @param index  : registerBuffers()中缓冲区的下标
+     * @param offset : 缓冲区内的偏移
+     */
+    void prepareWriteFixed(const Uart& uart, unsigned index, unsigned offset, unsigned length, uint64_t userData) {
+        struct io_uring_sqe* sqe = queue(IORING_OP_WRITE_FIXED, fdOf(uart), fixedAddress(index, offset, length), length, userData);
+
+        if (sqe != nullptr) {
+            sqe->buf_index = static_cast<uint16_t>(index);
+        }
+    }
+
+    /**
+     * @brief 添加多发读取请求
+     * @note 一次提交后，每当串口有数据到达都会产生一个完成事件，数据位于getBuffer(bufferId)。
+     *       完成事件的more为false时表示多发读取已结束（例如缓冲区耗尽），需要重新添加。
+     */
+    void prepareReadMultishot(const Uart& uart, uint64_t userData) {
+        if (_bufPool.empty()) {
+            throw std::logic_error("Buffers are not provided.");
+        }
+
+        struct io_uring_sqe* sqe = queue(kOpReadMultishot, fdOf(uart), nullptr, 0, userData);
+        sqe->flags    |= IOSQE_BUFFER_SELECT;
+        sqe->buf_group = kBufferGroup;
+    }
+
+    /**
+     * @brief 提交所有已添加的请求
+     * @param waitNr : 至少等待完成的请求数，默认为0（不等待）
+     * @return 本次提交的请求数
+     */
+    int submit(unsigned waitNr = 0) {
+        if (!isUringEnabled()) {
+            return runFallback();
+        }
+
+        __atomic_store_n(_sqTail, _sqLocalTail, __ATOMIC_RELEASE);
+
+        unsigned flags = waitNr > 0 ? IORING_ENTER_GETEVENTS : 0;
+        int ret;
+
+        do {
+            ret = static_cast<int>(syscall(__NR_io_uring_enter, _ringFd, _toSubmit, waitNr, flags, nullptr, 0));
+        } while (ret == -1 && errno == EINTR);
+
+        if (ret == -1) {
+            throw std::runtime_error("Error in submitting io_uring requests.");
+        }
+
+        _toSubmit -= static_cast<unsigned>(ret);
+
+        return ret;
+    } /* int submit(unsigned waitNr = 0) { */
+
+    /**
+     * @brief 处理所有已完成的请求
+     * @param handler : 形如void(const UartCompletion&)的回调
+     * @return 处理的完成事件数
+     */
+    template <typename Handler>
+    unsigned reap(Handler&& handler) {
+        unsigned count = 0;
+
+        if (!isUringEnabled()) {
+            for (size_t i = 0; i < _done.size(); ++i) {
+                handler(_done[i]);
+            }
+
+            count = static_cast<unsigned>(_done.size());
+            _done.clear();
+
+            return count;
+        }
+
+        unsigned head = *_cqHead;
+        unsigned tail = __atomic_load_n(_cqTail, __ATOMIC_ACQUIRE);
+
+        while (head != tail) {
+            const struct io_uring_cqe& cqe = _cqes[head & *_cqMask];
+            ++head;
+
+            if (cqe.user_data == kInternal) {
+                ++_internalCompletions;
+
+                if (cqe.res < 0) {
+                    ++_internalErrors;
+                    _lastInternalError = -cqe.res;
+                }
+                continue;
+            }
+
+            UartCompletion c;
+            c.userData = cqe.user_data;
+            c.result   = cqe.res;
+            c.bufferId = (cqe.flags & IORING_CQE_F_BUFFER) ? static_cast<int>(cqe.flags >> IORING_CQE_BUFFER_SHIFT) : -1;
+            c.more     = (cqe.flags & IORING_CQE_F_MORE) != 0;
+
+            handler(c);
+            ++count;
+        }
+
+        __atomic_store_n(_cqHead, head, __ATOMIC_RELEASE);
+
+        return count;
+    } /* unsigned reap(Handler&& handler) { */
+
+private:
+    // 6.1内核头文件中尚未定义该操作码
+    static const uint8_t  kOpReadMultishot = 49;
+    static const uint16_t kBufferGroup     = 0;
+    // 内部请求（提供缓冲区）的用户数据，其完成事件不会交给调用者
+    static const uint64_t kInternal        = ~static_cast<uint64_t>(0);
+
+    /**
+     * @brief 待回退执行的请求
+     */
+    struct Pending {
+        uint8_t  opcode;
+        int      fd;
+        void*    addr;
+        unsigned length;
+        uint64_t userData;
+    };
+
+    void setup(unsigned entries) {
+        struct io_uring_params params;
+        std::memset(&params, 0, sizeof(params));
+
+        _ringFd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+
+        if (_ringFd == -1) {
+            // ENOSYS、EPERM等情况下回退为同步read()/write()
+            return;
+        }
+
+        _sqSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        _cqSize = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+
+        bool single = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+
+        if (single) {
+            _sqSize = _cqSize = (_sqSize > _cqSize ? _sqSize : _cqSize);
+        }
+
+        _sqPtr = ::mmap(nullptr, _sqSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                        _ringFd, IORING_OFF_SQ_RING);
+        _cqPtr = single ? _sqPtr
+                        : ::mmap(nullptr, _cqSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                 _ringFd, IORING_OFF_CQ_RING);
+        _sqesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+        _sqes = static_cast<struct io_uring_sqe*>(
+            ::mmap(nullptr, _sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                   _ringFd, IORING_OFF_SQES));
+
+        if (_sqPtr == MAP_FAILED || _cqPtr == MAP_FAILED || _sqes == MAP_FAILED) {
+            teardown();
+            throw std::runtime_error("Error in mapping io_uring rings.");
+        }
+
+        char* sq = static_cast<char*>(_sqPtr);
+        char* cq = static_cast<char*>(_cqPtr);
+
+        _sqHead      = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+        _sqTail      = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        _sqMask      = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        _sqArray     = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        _sqEntries   = params.sq_entries;
+        _sqLocalTail = *_sqTail;
+        _cqHead      = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        _cqTail      = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        _cqMask      = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        _cqes        = reinterpret_cast<struct io_uring_cqe*>(cq + params.cq_off.cqes);
+
+        _multishot = probe(kOpReadMultishot);
+    } /* void setup(unsigned entries) { */
+
+    void teardown() {
+        if (_sqes != nullptr && _sqes != MAP_FAILED) {
+            ::munmap(_sqes, _sqesSize);
+        }
+
+        if (_cqPtr != nullptr && _cqPtr != MAP_FAILED && _cqPtr != _sqPtr) {
+            ::munmap(_cqPtr, _cqSize);
+        }
+
+        if (_sqPtr != nullptr && _sqPtr != MAP_FAILED) {
+            ::munmap(_sqPtr, _sqSize);
+        }
+
+        _sqes  = nullptr;
+        _cqPtr = nullptr;
+        _sqPtr = nullptr;
+
+        if (_ringFd != -1) {
+            ::close(_ringFd);
+            _ringFd = -1;
+        }
+    } /* void teardown() { */
+
+    /**
+     * @brief 查询内核是否支持指定的操作码
+     */
+    bool probe(uint8_t opcode) const {
+        const unsigned opsLen = 256;
+        std::vector<char> storage(sizeof(struct io_uring_probe) + opsLen * sizeof(struct io_uring_probe_op), 0);
+        struct io_uring_probe* p = reinterpret_cast<struct io_uring_probe*>(storage.data());
+
+        if (syscall(__NR_io_uring_register, _ringFd, IORING_REGISTER_PROBE, p, opsLen) == -1) {
+            return false;
+        }
+
+        return opcode <= p->last_op && (p->ops[opcode].flags & IO_URING_OP_SUPPORTED) != 0;
+    }
+
+    void* fixedAddress(unsigned index, unsigned offset, unsigned length) const {
+        if (index >= _fixed.size() || static_cast<size_t>(offset) + length > _fixed[index].iov_len) {
+            throw std::out_of_range("Fixed buffer range is out of bounds.");
+        }
+
+        return static_cast<char*>(_fixed[index].iov_base) + offset;
+    }
+
+    int fdOf(const Uart& uart) const {
+        if (uart.getFd() < 0) {
+            throw std::invalid_argument("UART port has no valid file descriptor.");
+        }
+
+        return uart.getFd();
+    }
+
+    /**
+     * @brief 将请求写入提交队列，队列已满时先提交一次
+     * @note 提交后内核仍未取走任何请求（例如完成队列溢出）时抛出std::runtime_error，不会覆盖未提交的请求
+     */
+    struct io_uring_sqe* queue(uint8_t opcode, int fd, const void* addr, unsigned length, uint64_t userData) {
+        if (!isUringEnabled()) {
+            Pending p = {opcode, fd, const_cast<void*>(addr), length, userData};
+            _pending.push_back(p);
+            return nullptr;
+        }
+
+        if (_sqLocalTail - __atomic_load_n(_sqHead, __ATOMIC_ACQUIRE) >= _sqEntries) {
+            submit();
+
+            if (_sqLocalTail - __atomic_load_n(_sqHead, __ATOMIC_ACQUIRE) >= _sqEntries) {
+                throw std::runtime_error("io_uring submission queue is full.");
+            }
+        }
+
+        unsigned index = _sqLocalTail & *_sqMask;
+        struct io_uring_sqe* sqe = &_sqes[index];
+        std::memset(sqe, 0, sizeof(*sqe));
+
+        sqe->opcode    = opcode;
+        sqe->fd        = fd;
+        sqe->addr      = reinterpret_cast<uint64_t>(addr);
+        sqe->len       = length;
+        sqe->user_data = userData;
+
+        _sqArray[index] = index;
+        ++_sqLocalTail;
+        ++_toSubmit;
+
+        return sqe;
+    } /* struct io_uring_sqe* queue(...) { */
+
+    /**
+     * @brief 回退路径：逐个执行read()/write()，结果在reap()中返回
+     */
+    int runFallback() {
+        for (size_t i = 0; i < _pending.size(); ++i) {
+            const Pending& p = _pending[i];
+            ssize_t ret;
+
+            if (p.opcode == IORING_OP_READ || p.opcode == IORING_OP_READ_FIXED) {
+                ret = ::read(p.fd, p.addr, p.length);
+            } else {
+                ret = ::write(p.fd, p.addr, p.length);
+            }
+
+            UartCompletion c;
+            c.userData = p.userData;
+            c.result   = ret == -1 ? -errno : static_cast<int>(ret);
+            c.bufferId = -1;
+            c.more     = false;
+            _done.push_back(c);
+        } /* for (size_t i = 0; i < _pending.size(); ++i) { */
+
+        int count = static_cast<int>(_pending.size());
+        _pending.clear();
+
+        return count;
+    } /* int runFallback() { */
+
+    int _ringFd;                      // io_uring实例，-1表示使用回退路径
+    void* _sqPtr;                     // 提交队列映射
+    void* _cqPtr;                     // 完成队列映射
+    struct io_uring_sqe* _sqes;       // 提交队列项数组
+    size_t _sqSize;
+    size_t _cqSize;
+    size_t _sqesSize;
+
+    unsigned* _sqHead;
+    unsigned* _sqTail;
+    unsigned* _sqMask;
+    unsigned* _sqArray;
+    unsigned _sqEntries;
+    unsigned _sqLocalTail;            // 尚未发布给内核的队尾
+    unsigned _toSubmit;               // 已写入但尚未提交的请求数
+    unsigned* _cqHead;
+    unsigned* _cqTail;
+    unsigned* _cqMask;
+    struct io_uring_cqe* _cqes;
+
+    bool _multishot;                  // 是否支持多发读取
+    unsigned _bufSize;                // 缓冲区池中单个缓冲区的大小
+    std::vector<char> _bufPool;       // 提供给内核的缓冲区池
+    uint64_t _internalCompletions;    // 内部请求的完成事件数
+    uint64_t _internalErrors;         // 失败的内部请求数
+    int _lastInternalError;           // 最近一次失败的内部请求的errno
+
+    std::vector<struct iovec> _fixed;     // 已注册的固定缓冲区
+    std::vector<Pending> _pending;        // 回退路径：待执行的请求
+    std::vector<UartCompletion> _done;    // 回退路径：已完成的请求
+};
+
+#endif /* __UART_URING_HPP */
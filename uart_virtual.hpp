@@ -0,0 +1,570 @@
+#ifndef __UART_VIRTUAL_HPP
+#define __UART_VIRTUAL_HPP
+
+// 标准库
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+#include "uart.hpp"
+#include "uart_transport.hpp"
+
+/**
+ * @brief 虚拟串口对，无需硬件即可对协议栈进行压力测试
+ * @note 按波特率、数据位、校验位与停止位模拟线路速率：一个字节在发送端线路空闲后开始传输，
+ *       经过一帧的时间才在对端可见；连续发送时逐字节排队。可按配置加入到达时间抖动、丢字节与位翻转，
+ *       随机数由种子决定，相同的操作序列总是得到相同的结果。
+ *       启用虚拟时间后，时间只在等待（wait()、receiveFor()等）或advance()时前进，
+ *       等待会直接跳到下一个字节到达的时刻，不真正休眠，便于在CI中快速、确定地复现时序问题。
+ *       提供与Uart相同的非抛出接口与带截止时间的接口，并可作为传输层使用。线程安全
+ */
+class VirtualUart : public UartTransport<VirtualUart> {
+public:
+    typedef Uart::Clock Clock;
+
+    /**
+     * @brief 线路模型
+     */
+    struct Model {
+        Clock::duration jitter; // 每个字节到达时间的最大随机延后（字节之间保持先后顺序）
+        double dropRate;        // 丢失一个字节的概率（0~1）
+        double corruptRate;     // 字节中随机一位翻转的概率（0~1）
+        uint64_t seed;          // 随机数种子
+        size_t capacity;        // 每个方向尚未送达的字节数上限，模拟发送缓冲区
+        bool virtualTime;       // 是否使用虚拟时间
+    };
+
+    /**
+     * @brief 发送方向的统计信息
+     */
+    struct Stats {
+        uint64_t sent;      // 发送的字节数
+        uint64_t dropped;   // 丢失的字节数
+        uint64_t corrupted; // 发生位翻转的字节数
+    };
+
+    /**
+     * @brief 默认模型：无抖动、无丢失、无位翻转，缓冲区4096字节，使用真实时间
+     */
+    static Model defaultModel() {
+        Model model;
+        model.jitter      = Clock::duration::zero();
+        model.dropRate    = 0;
+        model.corruptRate = 0;
+        model.seed        = 1;
+        model.capacity    = 4096;
+        model.virtualTime = false;
+        return model;
+    }
+
+    /**
+     * @brief 创建一对相连的虚拟串口
+     * @param config : 线路参数，两端共用
+     * @param model  : 线路模型
+     */
+    static std::pair<VirtualUart, VirtualUart> openPair(const UartConfig& config = UartConfig(),
+                                                        const Model& model = defaultModel()) {
+        if (model.dropRate < 0 || model.dropRate > 1 || model.corruptRate < 0 || model.corruptRate > 1
+            || model.capacity == 0 || model.jitter < Clock::duration::zero()) {
+            throw std::invalid_argument("Invalid virtual UART model.");
+        }
+
+        std::shared_ptr<Link> link = std::make_shared<Link>();
+        link->model      = model;
+        link->rng        = model.seed;
+        link->origin     = Clock::now();
+        link->virtualNow = 0;
+        applyConfig(*link, config);
+
+        for (int i = 0; i < 2; ++i) {
+            link->open[i]            = true;
+            link->lines[i].wireFree  = 0;
+            link->lines[i].lastDue   = 0;
+            link->lines[i].stats.sent      = 0;
+            link->lines[i].stats.dropped   = 0;
+            link->lines[i].stats.corrupted = 0;
+        }
+
+        return std::make_pair(VirtualUart(link, 0), VirtualUart(link, 1));
+    } /* static std::pair<VirtualUart, VirtualUart> openPair(...) { */
+
+    /**
+     * @brief 发送数据（非阻塞）
+     * @return 成功时为进入线路的字节数（含随后被丢弃的字节）；发送缓冲区已满时为operation_would_block
+     */
+    UartResult trySend(const char* data, size_t length) noexcept {
+        std::lock_guard<std::mutex> lock(_link->mutex);
+        Link& link = *_link;
+
+        if (!link.open[_side]) {
+            return Uart::makeError(std::make_error_code(std::errc::bad_file_descriptor));
+        }
+
+        if (data == nullptr) {
+            return Uart::makeError(std::make_error_code(std::errc::invalid_argument));
+        }
+
+        Line& line = link.lines[_side];
+        int64_t now = nowNs(link);
+
+        if (line.wireFree < now) {
+            line.wireFree = static_cast<double>(now);
+        }
+
+        // 线路上尚未传完的字节占用发送缓冲区
+        double backlog = (line.wireFree - now) / link.byteNs;
+        size_t space   = backlog >= link.model.capacity ? 0 : link.model.capacity - static_cast<size_t>(backlog);
+        size_t count   = length < space ? length : space;
+
+        if (count == 0) {
+            return Uart::makeError(std::make_error_code(std::errc::operation_would_block));
+        }
+
+        for (size_t i = 0; i < count; ++i) {
+            line.wireFree += link.byteNs;
+
+            int64_t due = static_cast<int64_t>(std::ceil(line.wireFree));
+
+            if (link.jitterNs > 0) {
+                due += static_cast<int64_t>(random(link) % static_cast<uint64_t>(link.jitterNs + 1));
+            }
+
+            if (due < line.lastDue) {
+                due = line.lastDue;
+            }
+
+            line.lastDue = due;
+            line.stats.sent += 1;
+
+            if (link.model.dropRate > 0 && uniform(link) < link.model.dropRate) {
+                line.stats.dropped += 1;
+                continue;
+            }
+
+            // 只保留数据位
+            unsigned char value = static_cast<unsigned char>(data[i]) & link.dataMask;
+
+            if (link.model.corruptRate > 0 && uniform(link) < link.model.corruptRate) {
+                value ^= static_cast<unsigned char>(1u << (random(link) % link.config.dataBits));
+                line.stats.corrupted += 1;
+            }
+
+            Byte byte;
+            byte.due   = due;
+            byte.value = static_cast<char>(value);
+            line.queue.push_back(byte);
+        } /* for (size_t i = 0; i < count; ++i) { */
+
+        link.cond.notify_all();
+
+        return count;
+    } /* UartResult trySend(const char* data, size_t length) noexcept { */
+
+    /**
+     * @brief 接收已到达的数据（非阻塞）
+     * @return 接收的数据长度；没有已到达的数据时为operation_would_block
+     * @note 不会在数据末尾写入'\0'
+     */
+    UartResult tryReceive(char* buffer, size_t length) noexcept {
+        std::lock_guard<std::mutex> lock(_link->mutex);
+
+        if (!_link->open[_side]) {
+            return Uart::makeError(std::make_error_code(std::errc::bad_file_descriptor));
+        }
+
+        if (buffer == nullptr) {
+            return Uart::makeError(std::make_error_code(std::errc::invalid_argument));
+        }
+
+        return take(buffer, length, nowNs(*_link));
+    }
+
+    /**
+     * @brief 在指定时间内等待并接收数据，语义与Uart::receiveFor()相同
+     * @note 虚拟时间下timeout为虚拟时长
+     */
+    UartProgress receiveFor(char* buffer, size_t length, Clock::duration timeout) noexcept {
+        UartProgress progress = {0, 0, std::error_code()};
+        std::unique_lock<std::mutex> lock(_link->mutex);
+
+        if (!check(buffer, progress) || length == 0) {
+            return progress;
+        }
+
+        progress.error = readBefore(lock, buffer, length, deadlineAfter(*_link, timeout), progress.bytes);
+        return progress;
+    }
+
+    /**
+     * @brief 在截止时间前接收恰好length个字节，语义与Uart::receiveExact()相同
+     */
+    UartProgress receiveExact(char* buffer, size_t length, Clock::time_point deadline) noexcept {
+        UartProgress progress = {0, 0, std::error_code()};
+        std::unique_lock<std::mutex> lock(_link->mutex);
+
+        if (!check(buffer, progress)) {
+            return progress;
+        }
+
+        int64_t limit = toNs(*_link, deadline);
+
+        while (!progress.error && progress.bytes < length) {
+            size_t got = 0;
+            progress.error  = readBefore(lock, buffer + progress.bytes, length - progress.bytes, limit, got);
+            progress.bytes += got;
+        }
+
+        return progress;
+    } /* UartProgress receiveExact(char* buffer, size_t length, Clock::time_point deadline) noexcept { */
+
+    /**
+     * @brief 在截止时间前接收数据，直到收到分隔符，语义与Uart::receiveUntil()相同
+     */
+    UartProgress receiveUntil(char* buffer, size_t length, char delimiter, Clock::time_point deadline) noexcept {
+        UartProgress progress = {0, 0, std::error_code()};
+        std::unique_lock<std::mutex> lock(_link->mutex);
+
+        if (!check(buffer, progress)) {
+            return progress;
+        }
+
+        int64_t limit = toNs(*_link, deadline);
+
+        while (!progress.error) {
+            if (progress.bytes == length) {
+                progress.error = std::make_error_code(std::errc::no_buffer_space);
+                break;
+            }
+
+            size_t got = 0;
+            progress.error = readBefore(lock, buffer + progress.bytes, length - progress.bytes, limit, got);
+
+            const void* found = got > 0 ? std::memchr(buffer + progress.bytes, delimiter, got) : nullptr;
+            progress.bytes += got;
+
+            if (found != nullptr) {
+                progress.frame = static_cast<const char*>(found) - buffer + 1;
+                progress.error = std::error_code();
+                break;
+            }
+        } /* while (!progress.error) { */
+
+        return progress;
+    } /* UartProgress receiveUntil(char* buffer, size_t length, char delimiter, ...) noexcept { */
+
+    /**
+     * @brief 传输层接口
+     */
+    UartResult writeSome(const char* data, size_t length) noexcept {
+        return trySend(data, length);
+    }
+
+    UartResult readSome(char* buffer, size_t length) noexcept {
+        return tryReceive(buffer, length);
+    }
+
+    bool wait(short events, int timeoutMs) noexcept {
+        std::unique_lock<std::mutex> lock(_link->mutex);
+        int64_t deadline = timeoutMs < 0 ? kNever : nowNs(*_link) + static_cast<int64_t>(timeoutMs) * 1000000;
+
+        // 已关闭时视为就绪，由随后的收发报告std::errc::bad_file_descriptor
+        return waitUntil(lock, events, deadline) != std::errc::timed_out;
+    }
+
+    int getFd() const noexcept {
+        return -1;
+    }
+
+    /**
+     * @brief 修改线路参数，两端同时生效
+     * @note 已在线路上的字节按原速率到达
+     */
+    void reconfigure(const UartConfig& config) {
+        std::lock_guard<std::mutex> lock(_link->mutex);
+        applyConfig(*_link, config);
+    }
+
+    /**
+     * @brief 获取线路参数
+     */
+    UartConfig getConfig() const {
+        std::lock_guard<std::mutex> lock(_link->mutex);
+        return _link->config;
+    }
+
+    /**
+     * @brief 获取波特率
+     */
+    int getBaudRate() const {
+        return static_cast<int>(getConfig().baudRate);
+    }
+
+    /**
+     * @brief 当前时间，虚拟时间下为虚拟时钟
+     */
+    Clock::time_point now() const {
+        std::lock_guard<std::mutex> lock(_link->mutex);
+        return _link->origin + std::chrono::nanoseconds(nowNs(*_link));
+    }
+
+    /**
+     * @brief 推进虚拟时钟，使用真实时间时无效果
+     */
+    void advance(Clock::duration duration) {
+        std::lock_guard<std::mutex> lock(_link->mutex);
+
+        if (_link->model.virtualTime && duration > Clock::duration::zero()) {
+            _link->virtualNow += std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+            _link->cond.notify_all();
+        }
+    }
+
+    /**
+     * @brief 获取本端发送方向的统计信息
+     */
+    Stats getStats() const {
+        std::lock_guard<std::mutex> lock(_link->mutex);
+        return _link->lines[_side].stats;
+    }
+
+    /**
+     * @brief 关闭本端，此后的收发返回std::errc::bad_file_descriptor
+     * @note 正在其他线程中等待的wait()与receive*()会被唤醒
+     */
+    void close() {
+        std::lock_guard<std::mutex> lock(_link->mutex);
+        _link->open[_side] = false;
+        _link->cond.notify_all();
+    }
+
+    bool isOpen() const {
+        std::lock_guard<std::mutex> lock(_link->mutex);
+        return _link->open[_side];
+    }
+
+private:
+    static const int64_t kNever = std::numeric_limits<int64_t>::max();
+
+    /**
+     * @brief 线路上的一个字节
+     */
+    struct Byte {
+        int64_t due; // 在对端可见的时间
+        char value;  // 数据
+    };
+
+    /**
+     * @brief 单向线路
+     */
+    struct Line {
+        std::deque<Byte> queue; // 已发送、尚未被读取的字节
+        double wireFree;        // 线路空闲的时间，逐字节累加，保留小数避免高波特率下的累计误差
+        int64_t lastDue;        // 上一个字节的到达时间
+        Stats stats;            // 统计信息
+    };
+
+    /**
+     * @brief 两端共享的状态，时间均为相对origin的纳秒数
+     */
+    struct Link {
+        std::mutex mutex;
+        std::condition_variable cond;
+        UartConfig config;
+        Model model;
+        double byteNs;           // 一帧的传输时间
+        int64_t jitterNs;        // 最大抖动
+        unsigned char dataMask;  // 数据位掩码
+        uint64_t rng;            // 随机数状态
+        Clock::time_point origin; // 时间零点
+        int64_t virtualNow;      // 虚拟时钟
+        Line lines[2];           // lines[i]为第i端的发送方向
+        bool open[2];            // open[i]为第i端是否打开
+    };
+
+    VirtualUart(std::shared_ptr<Link> link, int side)
+        : _link(std::move(link))
+        , _side(side) {}
+
+    static void applyConfig(Link& link, const UartConfig& config) {
+        if (config.baudRate == 0 || config.dataBits < 5 || config.dataBits > 8
+            || (config.stopBits != 1 && config.stopBits != 2)
+            || (config.parity != 'N' && config.parity != 'E' && config.parity != 'O')) {
+            throw std::invalid_argument("Invalid virtual UART config.");
+        }
+
+        // 起始位 + 数据位 + 校验位 + 停止位
+        int bits = 1 + config.dataBits + (config.parity != 'N' ? 1 : 0) + config.stopBits;
+
+        link.config   = config;
+        link.byteNs   = bits * 1e9 / config.baudRate;
+        link.jitterNs = std::chrono::duration_cast<std::chrono::nanoseconds>(link.model.jitter).count();
+        link.dataMask = static_cast<unsigned char>((1u << config.dataBits) - 1);
+    }
+
+    /**
+     * @brief splitmix64，输出序列只由种子决定，与标准库实现无关
+     */
+    static uint64_t random(Link& link) noexcept {
+        uint64_t z = (link.rng += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    /**
+     * @brief [0, 1)上的均匀分布
+     */
+    static double uniform(Link& link) noexcept {
+        return (random(link) >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    static int64_t nowNs(const Link& link) noexcept {
+        if (link.model.virtualTime) {
+            return link.virtualNow;
+        }
+
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - link.origin).count();
+    }
+
+    static int64_t toNs(const Link& link, Clock::time_point deadline) noexcept {
+        if (deadline == Clock::time_point::max()) {
+            return kNever;
+        }
+
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - link.origin).count();
+    }
+
+    static int64_t deadlineAfter(const Link& link, Clock::duration timeout) noexcept {
+        int64_t ns  = std::chrono::duration_cast<std::chrono::nanoseconds>(timeout).count();
+        int64_t now = nowNs(link);
+        return ns > kNever - now ? kNever : now + ns;
+    }
+
+    /**
+     * @brief 检查本端已打开、缓冲区有效，调用时须持有锁
+     */
+    bool check(const char* buffer, UartProgress& progress) const noexcept {
+        if (!_link->open[_side]) {
+            progress.error = std::make_error_code(std::errc::bad_file_descriptor);
+        } else if (buffer == nullptr) {
+            progress.error = std::make_error_code(std::errc::invalid_argument);
+        }
+
+        return !progress.error;
+    }
+
+    /**
+     * @brief 取出已到达的字节，调用时须持有锁
+     */
+    UartResult take(char* buffer, size_t length, int64_t now) noexcept {
+        std::deque<Byte>& queue = _link->lines[1 - _side].queue;
+        size_t count = 0;
+
+        while (count < length && !queue.empty() && queue.front().due <= now) {
+            buffer[count++] = queue.front().value;
+            queue.pop_front();
+        }
+
+        if (count == 0) {
+            return Uart::makeError(std::make_error_code(std::errc::operation_would_block));
+        }
+
+        _link->cond.notify_all();
+        return count;
+    }
+
+    /**
+     * @brief 等待可读或可写，调用时须持有锁
+     * @param deadline : 截止时间（纳秒），kNever表示一直等待
+     * @return 为空表示就绪；到期为std::errc::timed_out，本端已关闭为std::errc::bad_file_descriptor
+     * @note 虚拟时间下直接把时钟推进到下一个字节到达（或发送缓冲区腾出空间）的时刻，不休眠
+     */
+    std::error_code waitUntil(std::unique_lock<std::mutex>& lock, short events, int64_t deadline) noexcept {
+        Link& link = *_link;
+
+        for (;;) {
+            // close()会唤醒等待者，每次醒来都要重新检查
+            if (!link.open[_side]) {
+                return std::make_error_code(std::errc::bad_file_descriptor);
+            }
+
+            int64_t now  = nowNs(link);
+            int64_t next = kNever;
+
+            if (events & POLLIN) {
+                const std::deque<Byte>& queue = link.lines[1 - _side].queue;
+
+                if (!queue.empty()) {
+                    if (queue.front().due <= now) {
+                        return std::error_code();
+                    }
+                    next = queue.front().due;
+                }
+            } else {
+                const Line& line = link.lines[_side];
+                double ready = line.wireFree - (link.model.capacity - 1) * link.byteNs;
+
+                if (ready <= now) {
+                    return std::error_code();
+                }
+                next = static_cast<int64_t>(std::ceil(ready));
+            } /* if (events & POLLIN) { */
+
+            if (link.model.virtualTime) {
+                if (next <= deadline && next != kNever) {
+                    link.virtualNow = next > link.virtualNow ? next : link.virtualNow;
+                    continue;
+                }
+
+                if (deadline != kNever) {
+                    link.virtualNow = deadline > link.virtualNow ? deadline : link.virtualNow;
+                    return std::make_error_code(std::errc::timed_out);
+                }
+
+                // 线路上没有数据，等待对端发送
+                link.cond.wait(lock);
+                continue;
+            } /* if (link.model.virtualTime) { */
+
+            if (now >= deadline) {
+                return std::make_error_code(std::errc::timed_out);
+            }
+
+            int64_t wake = next < deadline ? next : deadline;
+
+            if (wake == kNever) {
+                link.cond.wait(lock);
+            } else {
+                link.cond.wait_until(lock, link.origin + std::chrono::nanoseconds(wake));
+            }
+        } /* for (;;) { */
+    } /* std::error_code waitUntil(std::unique_lock<std::mutex>& lock, short events, int64_t deadline) noexcept { */
+
+    /**
+     * @brief 在截止时间前读到至少1个字节，调用时须持有锁
+     */
+    std::error_code readBefore(std::unique_lock<std::mutex>& lock, char* buffer, size_t length,
+                               int64_t deadline, size_t& got) noexcept {
+        std::error_code error = waitUntil(lock, POLLIN, deadline);
+
+        if (error) {
+            return error;
+        }
+
+        got = *take(buffer, length, nowNs(*_link));
+        return std::error_code();
+    }
+
+    std::shared_ptr<Link> _link; // 两端共享的线路
+    int _side;                   // 本端编号（0或1）
+};
+
+#endif /* __UART_VIRTUAL_HPP */